@@ -199,6 +199,15 @@ struct State {
         mapping.set_mapping(g1_vertex, g2_vertex);
         availableVertices.erase(g2_vertex);
     }
+
+    void remove_mapping(const Vertex g1_vertex)
+    {
+        const MappedVertex old_g2 = mapping.get_mapping_g1_to_g2(g1_vertex);
+        if (old_g2 != -1) {
+            availableVertices.insert(old_g2);
+            mapping.remove_mapping_g1(g1_vertex);
+        }
+    }
 };
 
 #endif  // STATE_HPP
@@ -1,10 +1,24 @@
 #include "algos.hpp"
-
+#include "assignment_kernels.hpp"
+#include "beam.hpp"
+#include "colour_refinement.hpp"
+#include "domains.hpp"
+#include "external_open_list.hpp"
+#include "pair_bounds.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <climits>
+#include <iostream>
 #include <map>
-#include <queue>
+#include <memory>
+#include <optional>
+#include <random>
+#include <tuple>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 // ------------------------------
@@ -100,11 +114,38 @@ static int calculate_incremental_cost(const Graph &g1, const Graph &g2, const Ma
     return cost;
 }
 
+static void keep_best_mapping(
+    const int k, const Mapping &mapping, const int cost, std::multimap<int, Mapping> &best_mappings
+)
+{
+    if (is_mapping_present(mapping, best_mappings)) {
+        return;
+    }
+
+    if (best_mappings.size() < static_cast<size_t>(k)) {
+        best_mappings.insert({cost, mapping});
+    } else {
+        if (cost < best_mappings.rbegin()->first) {
+            best_mappings.erase(std::prev(best_mappings.end()));
+            best_mappings.insert({cost, mapping});
+        }
+    }
+}
+
+/* stopped_at receives the partial mapping and its cost at the first node that saw the stop request */
 static void BruteForceRecursive(
     const Graph &g1, const Graph &g2, const int k, Mapping &current_mapping, int current_cost,
-    std::vector<bool> &used_g2_vertices, const std::int32_t depth, std::multimap<int, Mapping> &best_mappings
+    std::vector<bool> &used_g2_vertices, const std::int32_t depth, std::multimap<int, Mapping> &best_mappings,
+    std::optional<std::pair<Mapping, int>> &stopped_at, SearchContext &ctx
 )
 {
+    if (ctx.ShouldStop()) {
+        if (!stopped_at.has_value()) {
+            stopped_at.emplace(current_mapping, current_cost);
+        }
+        return;
+    }
+
     if (!best_mappings.empty() && best_mappings.size() == static_cast<size_t>(k)) {
         if (current_cost >= best_mappings.rbegin()->first) {
             return;
@@ -112,21 +153,12 @@ static void BruteForceRecursive(
     }
 
     if (depth == static_cast<std::int32_t>(g1.GetVertices())) {
-        if (is_mapping_present(current_mapping, best_mappings)) {
-            return;
-        }
-
-        if (best_mappings.size() < static_cast<size_t>(k)) {
-            best_mappings.insert({current_cost, current_mapping});
-        } else {
-            if (current_cost < best_mappings.rbegin()->first) {
-                best_mappings.erase(std::prev(best_mappings.end()));
-                best_mappings.insert({current_cost, current_mapping});
-            }
-        }
+        keep_best_mapping(k, current_mapping, current_cost, best_mappings);
+        ctx.OfferIncumbent(current_mapping, current_cost);
         return;
     }
 
+    ctx.RecordExpansion(static_cast<std::size_t>(depth), current_cost);
     for (Vertex candidate = 0; candidate < g2.GetVertices(); ++candidate) {
         if (used_g2_vertices[candidate]) {
             continue;
@@ -137,7 +169,8 @@ static void BruteForceRecursive(
 
         const int incremental_cost = calculate_incremental_cost(g1, g2, current_mapping, depth);
         BruteForceRecursive(
-            g1, g2, k, current_mapping, current_cost + incremental_cost, used_g2_vertices, depth + 1, best_mappings
+            g1, g2, k, current_mapping, current_cost + incremental_cost, used_g2_vertices, depth + 1, best_mappings,
+            stopped_at, ctx
         );
 
         used_g2_vertices[candidate] = false;
@@ -149,7 +182,16 @@ static void BruteForceRecursive(
 // Accurate Brute Force
 // ------------------------------
 
+/* Defined with the A* helpers */
+static void GreedyComplete_(const Graph &g1, const Graph &g2, const PairLowerBounds &bounds, State &state, int &g);
+
 std::vector<Mapping> AccurateBruteForce(const Graph &g1, const Graph &g2, int k)
+{
+    SearchContext ctx{};
+    return AccurateBruteForce(g1, g2, k, ctx);
+}
+
+std::vector<Mapping> AccurateBruteForce(const Graph &g1, const Graph &g2, int k, SearchContext &ctx)
 {
     if (g1.GetVertices() > g2.GetVertices()) {
         return {};
@@ -159,7 +201,33 @@ std::vector<Mapping> AccurateBruteForce(const Graph &g1, const Graph &g2, int k)
     Mapping current_mapping(g1.GetVertices(), g2.GetVertices());
     std::vector<bool> used_g2_vertices(g2.GetVertices(), false);
 
-    BruteForceRecursive(g1, g2, k, current_mapping, 0, used_g2_vertices, 0, best_mappings);
+    std::optional<std::pair<Mapping, int>> stopped_at{};
+
+    BruteForceRecursive(g1, g2, k, current_mapping, 0, used_g2_vertices, 0, best_mappings, stopped_at, ctx);
+    if (!ctx.ShouldStop()) {
+        ctx.RaiseLowerBound(ctx.GetIncumbentCost());
+    } else {
+        /* Interrupted: the branch being searched is completed greedily, like the other engines do */
+        if (stopped_at.has_value()) {
+            const PairLowerBounds bounds(g1, g2);
+            State state(g1.GetVertices(), g2.GetVertices());
+            for (Vertex v1 = 0; v1 < g1.GetVertices(); ++v1) {
+                if (stopped_at->first.is_g1_mapped(v1)) {
+                    state.set_mapping(v1, static_cast<Vertex>(stopped_at->first.get_mapping_g1_to_g2(v1)));
+                }
+            }
+
+            int cost = stopped_at->second;
+            GreedyComplete_(g1, g2, bounds, state, cost);
+            ctx.OfferIncumbent(state.mapping, cost);
+            keep_best_mapping(k, state.mapping, cost, best_mappings);
+        }
+
+        if (best_mappings.empty()) {
+            auto incumbent = ctx.GetIncumbent();
+            return incumbent.has_value() ? std::vector<Mapping>{*incumbent} : std::vector<Mapping>{};
+        }
+    }
 
     std::vector<Mapping> result;
     result.reserve(best_mappings.size());
@@ -174,8 +242,22 @@ std::vector<Mapping> AccurateBruteForce(const Graph &g1, const Graph &g2, int k)
 // A star helpers
 // ------------------------------
 
-static Vertex PickNextVertex_(const Graph &g1, const State &state)
+/* The first vertex is the one with the most neighbours, or the start_rank-th one by that count. Later vertices are
+ * the most constrained by the mapped ones. Only which G1 vertices are mapped matters, never their images, so all
+ * nodes of one depth branch on the same vertex; AStarSearch_ relies on it. */
+static Vertex PickNextVertex_(const Graph &g1, const State &state, const Vertices start_rank = 0)
 {
+    if (state.mapping.get_mapped_count() == 0 && start_rank != 0) {
+        std::vector<Vertex> order(g1.GetVertices());
+        for (Vertex v1 = 0; v1 < g1.GetVertices(); ++v1) {
+            order[v1] = v1;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](const Vertex a, const Vertex b) {
+            return g1.GetNumOfNeighbours(a) > g1.GetNumOfNeighbours(b);
+        });
+        return order[std::min<Vertices>(start_rank, g1.GetVertices() - 1)];
+    }
+
     if (state.mapping.get_mapped_count() == 0) {
         Vertex best_v1         = ~static_cast<Vertex>(0);
         Vertices max_neighbors = 0;
@@ -240,14 +322,6 @@ static int CalculateSingleDirectionEdgesAdditions_(
     return cost;
 }
 
-static int CalculateEdgesAdditions_(const Graph &g1, Vertex v1, Vertex u1, const Graph &g2, Vertex v2, Vertex u2)
-{
-    int cost = 0;
-    cost += CalculateSingleDirectionEdgesAdditions_(g1, v1, u1, g2, v2, u2);
-    cost += CalculateSingleDirectionEdgesAdditions_(g1, u1, v1, g2, u2, v2);
-    return cost;
-}
-
 static int CalculateAssignmentCost_(const Graph &g1, const Graph &g2, const Mapping &mapping, Vertex v1, Vertex v2)
 {
     int cost = 0;
@@ -277,268 +351,1148 @@ static int CalculateAssignmentCost_(const Graph &g1, const Graph &g2, const Mapp
     return cost;
 }
 
-static int CalculateHeuristic_(const Graph &g1, const Graph &g2, const State &state)
+/* Admissible estimate of the cost still to come: for every unmapped vertex its cheapest viable candidate, counting the
+ * partial assignment cost plus half of what remains of the static bound. The rest of the static bound comes from
+ * edges towards unmapped vertices, which are shared with their other endpoint, so only half of it may be claimed. */
+static int CalculateHeuristic_(
+    const Graph &g1, const PairLowerBounds &bounds, const State &state, const CandidateDomains &domains
+)
 {
     int h = 0;
     for (Vertex v1 = 0; v1 < g1.GetVertices(); ++v1) {
         if (state.mapping.is_g1_mapped(v1)) {
             continue;
         }
-        int min_cost = INT_MAX;
-
-        for (Vertex v2 : state.availableVertices) {
-            int cost_candidate = 0;
-            g1.IterateNeighbours(
-                [&](Vertex neighbour) {
-                    if (!state.mapping.is_g1_mapped(neighbour)) {
-                        return;
-                    }
-
-                    const MappedVertex u2 = state.mapping.get_mapping_g1_to_g2(neighbour);
-                    assert(u2 != -1);
+        const int min_cost = domains.GetMinBlendedCost(bounds, v1);
 
-                    cost_candidate += CalculateEdgesAdditions_(g1, v1, neighbour, g2, v2, u2);
-                },
-                v1
-            );
-            min_cost = std::min(min_cost, cost_candidate);
-        }
+        assert(min_cost != INT_MAX);
         h += min_cost;
     }
     return h;
 }
 
+/* Free G2 vertices ordered by their static bound against v1, ties by index or randomly when a generator is given. */
+static std::vector<Vertex> SortByBound_(
+    const PairLowerBounds &bounds, std::vector<Vertex> candidates, const Vertex v1, std::mt19937 *generator = nullptr
+)
+{
+    if (generator != nullptr) {
+        std::shuffle(candidates.begin(), candidates.end(), *generator);
+        std::stable_sort(candidates.begin(), candidates.end(), [&](const Vertex a, const Vertex b) {
+            return bounds.Get(v1, a) < bounds.Get(v1, b);
+        });
+        return candidates;
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [&](const Vertex a, const Vertex b) {
+        const int bound_a = bounds.Get(v1, a);
+        const int bound_b = bounds.Get(v1, b);
+        return bound_a != bound_b ? bound_a < bound_b : a < b;
+    });
+    return candidates;
+}
+
+static std::vector<Vertex> OrderCandidates_(const PairLowerBounds &bounds, const State &state, const Vertex v1)
+{
+    return SortByBound_(bounds, {state.availableVertices.begin(), state.availableVertices.end()}, v1);
+}
+
+static std::vector<Vertex> OrderCandidates_(
+    const PairLowerBounds &bounds, const CandidateDomains &domains, const Vertex v1, std::mt19937 *generator = nullptr
+)
+{
+    std::vector<Vertex> candidates;
+    domains.IterateDomain(
+        [&](const Vertex v2) {
+            candidates.push_back(v2);
+        },
+        v1
+    );
+    return SortByBound_(bounds, std::move(candidates), v1, generator);
+}
+
 // ------------------------------
 // A star
 // ------------------------------
 
 struct AStarState {
     State state;
+    CandidateDomains domains;
     int g;  // Real cost so far
     int f;  // f = g + h (priority)
 
     AStarState() : state(0, 0), g(0), f(0) {}
 
-    AStarState(std::int32_t size_g1, std::int32_t size_g2) : state(size_g1, size_g2), g(0), f(0) {}
-
-    AStarState(const State &s, int cost_g, int cost_f) : state(s), g(cost_g), f(cost_f) {}
+    AStarState(const Graph &g1, const Graph &g2)
+        : state(g1.GetVertices(), g2.GetVertices()), domains(g1, g2), g(0), f(0)
+    {
+    }
 
     bool operator>(const AStarState &other) const { return f > other.f; }
 };
 
+/* Builds the child of node that maps v1 -> v2. Returns false if forward checking proves that the child cannot get
+ * below the threshold. */
+static bool MakeChild_(
+    const Graph &g1, const Graph &g2, const PairLowerBounds &bounds, const AStarState &node, const Vertex v1,
+    const Vertex v2, const int threshold, AStarState &child
+)
+{
+    assert(node.domains.GetPartialCost(v1, v2) == CalculateAssignmentCost_(g1, g2, node.state.mapping, v1, v2));
+
+    child.g = node.g + node.domains.GetPartialCost(v1, v2);
+    if (child.g >= threshold) {
+        return false;
+    }
+
+    child.state   = node.state;
+    child.domains = node.domains;
+    child.state.set_mapping(v1, v2);
+
+    if (!child.domains.Assign(g1, g2, bounds, child.state.mapping, v1, v2, child.g, threshold)) {
+        return false;
+    }
+
+    child.f = child.g + CalculateHeuristic_(g1, bounds, child.state, child.domains);
+    return true;
+}
+
+/* Number of expansions between two greedy dives in the anytime mode. */
+static constexpr std::uint64_t kDiveInterval = 256;
+
+/* costs[v2] = CalculateAssignmentCost_(g1, g2, mapping, v1, v2) for every G2 vertex, one pass over G2 per mapped
+ * neighbour of v1 instead of one pass over the neighbours per candidate. diagonal holds the self-loops of G2. */
+static void CalculateAssignmentCosts_(
+    const Graph &g1, const Graph &g2, const Mapping &mapping, const Vertex v1, const std::vector<Edges> &diagonal,
+    std::vector<Edges> &column, std::vector<int> &costs
+)
+{
+    costs.assign(g2.GetVertices(), 0);
+    AddEdgeDeficits(costs.data(), diagonal.data(), g1.GetEdges(v1, v1), nullptr, 0, g2.GetVertices());
+
+    g1.IterateNeighbours(
+        [&](const Vertex neighbour) {
+            if (neighbour == v1 || !mapping.is_g1_mapped(neighbour)) {
+                return;
+            }
+
+            /* Edges v2 -> u2 come from a column of G2, edges u2 -> v2 from a row */
+            const auto u2         = static_cast<Vertex>(mapping.get_mapping_g1_to_g2(neighbour));
+            const Edges edges_out = g1.GetEdges(v1, neighbour);
+            if (edges_out != 0) {
+                GatherColumn(g2, u2, column.data());
+            }
+            AddEdgeDeficits(
+                costs.data(), column.data(), edges_out, g2.GetRow(u2), g1.GetEdges(neighbour, v1), g2.GetVertices()
+            );
+        },
+        v1
+    );
+}
+
+/* Completes the partial state by greedily taking the cheapest assignment for each next vertex. Works on the plain
+ * state, as the domains of a node may already be restricted by an incumbent. */
+static void GreedyComplete_(const Graph &g1, const Graph &g2, const PairLowerBounds &bounds, State &state, int &g)
+{
+    std::vector<Edges> diagonal(g2.GetVertices());
+    std::vector<Edges> column(g2.GetVertices());
+    std::vector<int> costs{};
+    GatherDiagonal(g2, diagonal.data());
+
+    while (state.mapping.get_mapped_count() < g1.GetVertices()) {
+        const Vertex v1 = PickNextVertex_(g1, state);
+        CalculateAssignmentCosts_(g1, g2, state.mapping, v1, diagonal, column, costs);
+
+        /* Candidates come ordered by static bound, so ties on cost go to the most promising vertex */
+        Vertex best_v2 = 0;
+        int best_cost  = INT_MAX;
+        for (const Vertex v2 : OrderCandidates_(bounds, state, v1)) {
+            const int cost = costs[v2];
+            assert(cost == CalculateAssignmentCost_(g1, g2, state.mapping, v1, v2));
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_v2   = v2;
+            }
+        }
+
+        assert(best_cost != INT_MAX);
+        state.set_mapping(v1, best_v2);
+        g += best_cost;
+    }
+}
+
+static void OfferGreedyCompletion_(
+    const Graph &g1, const Graph &g2, const PairLowerBounds &bounds, const AStarState &node, SearchContext &ctx
+)
+{
+    State state = node.state;
+    int g       = node.g;
+    GreedyComplete_(g1, g2, bounds, state, g);
+    ctx.OfferIncumbent(state.mapping, g);
+}
+
 std::vector<Mapping> AccurateAStar(const Graph &g1, const Graph &g2, const int k)
+{
+    SearchContext ctx{};
+    return AccurateAStar(g1, g2, k, ctx);
+}
+
+/* The open list is moved into the frame of the coroutine */
+template <class OpenList>
+static SearchTask AStarSearch_(
+    const Graph &g1, const Graph &g2, SearchContext &ctx, const std::uint64_t slice, OpenList open
+)
 {
     if (g1.GetVertices() > g2.GetVertices()) {
-        return {};
+        co_return std::vector<Mapping>{};
+    }
+    const PairLowerBounds bounds(g1, g2);
+
+    AStarState initial = AStarState(g1, g2);
+
+    /* Anytime mode: start from a quick feasible mapping so that there is always something to report */
+    const bool anytime = ctx.HasDeadline();
+    if (anytime) {
+        OfferGreedyCompletion_(g1, g2, bounds, initial, ctx);
     }
-    std::priority_queue<AStarState, std::vector<AStarState>, std::greater<AStarState>> pq;
 
-    AStarState initial = AStarState(g1.GetVertices(), g2.GetVertices());
-    pq.push(initial);
+    open.Push(std::move(initial));
 
-    while (!pq.empty()) {
-        AStarState current = pq.top();
-        pq.pop();
+    /* The vertex every node of a depth branched on. With one G1 order for the whole tree a set of pairs can only be
+     * reached along one path, so the search cannot meet the same partial mapping twice and needs no closed list. */
+    std::vector<Vertex> branch_vertices(g1.GetVertices(), ~static_cast<Vertex>(0));
+
+    std::uint64_t expansions = 0;
+    std::uint64_t steps      = 0;
+    while (!open.IsEmpty()) {
+        ctx.RaiseLowerBound(open.GetMinF());
+
+        /* Nothing left on the open list can beat the incumbent */
+        if (open.GetMinF() >= ctx.GetIncumbentCost()) {
+            break;
+        }
+
+        /* Interrupted: the most promising open node is the best partial answer we have */
+        if (ctx.ShouldStop()) {
+            if (const std::optional<AStarState> top = open.PopMin(g1, g2, bounds, INT_MAX); top.has_value()) {
+                OfferGreedyCompletion_(g1, g2, bounds, *top, ctx);
+            }
+            break;
+        }
+
+        std::optional<AStarState> popped = open.PopMin(g1, g2, bounds, ctx.GetIncumbentCost());
+        if (!popped.has_value()) {
+            continue;
+        }
+        AStarState &current = *popped;
+        ctx.RecordExpansion(open.GetSize(), current.f);
 
         if (current.state.mapping.get_mapped_count() == g1.GetVertices()) {
-            return {current.state.mapping};
+            ctx.OfferIncumbent(current.state.mapping, current.g);
+            ctx.RaiseLowerBound(current.g);
+            co_return std::vector<Mapping>{current.state.mapping};
+        }
+
+        if (anytime && ++expansions % kDiveInterval == 0) {
+            OfferGreedyCompletion_(g1, g2, bounds, current, ctx);
         }
 
         const Vertex v1 = PickNextVertex_(g1, current.state);
 
-        for (Vertex v2 : current.state.availableVertices) {
-            AStarState next_state;
-            next_state.state = current.state;
-            next_state.state.set_mapping(v1, v2);
+        Vertex &branch_vertex = branch_vertices[current.state.mapping.get_mapped_count()];
+        assert(branch_vertex == ~static_cast<Vertex>(0) || branch_vertex == v1);
+        branch_vertex = v1;
+
+        current.domains.IterateDomain(
+            [&](const Vertex v2) {
+                /* Hopeless pair: the edges around v1 alone already reach the incumbent */
+                const int threshold = ctx.GetIncumbentCost();
+                if (current.g + bounds.Get(v1, v2) >= threshold) {
+                    return;
+                }
 
-            const int cost_increment = CalculateAssignmentCost_(g1, g2, current.state.mapping, v1, v2);
-            next_state.g             = current.g + cost_increment;
+                AStarState next_state;
+                if (!MakeChild_(g1, g2, bounds, current, v1, v2, threshold, next_state) ||
+                    next_state.f >= threshold) {
+                    return;
+                }
 
-            const int h  = CalculateHeuristic_(g1, g2, next_state.state);
-            next_state.f = next_state.g + h;
+                open.Push(std::move(next_state));
+            },
+            v1
+        );
 
-            pq.push(next_state);
+        if (slice != 0 && ++steps % slice == 0) {
+            co_yield SearchYield{};
         }
     }
 
-    return {};
-}
+    /* Open list exhausted means the incumbent is optimal */
+    if (open.IsEmpty() && !ctx.ShouldStop()) {
+        ctx.RaiseLowerBound(ctx.GetIncumbentCost());
+    }
 
-// ------------------------------
-// Approx A star
-// ------------------------------
+    if (auto incumbent = ctx.GetIncumbent(); incumbent.has_value()) {
+        co_return std::vector<Mapping>{*incumbent};
+    }
+    co_return std::vector<Mapping>{};
+}
 
-template <std::uint32_t R>
-struct PrioArr {
-    bool IsEmpty() { return used_ == 0; }
 
-    AStarState &PeekBest()
+/* Open list of AccurateAStar keeping whole nodes in memory. Nodes stay in a pool and the queue moves their handles,
+ * f being a small integer the queue is a bucket per value. */
+class InMemoryOpenList_
+{
+    public:
+    void Push(AStarState &&node)
     {
-        assert(used_ > 0);
-        return table_[0];
+        const NodeHandle handle = pool_.Acquire();
+        const int f             = node.f;
+        pool_.Get(handle)       = std::move(node);
+        queue_.Push(f, handle);
     }
 
-    AStarState GetBest()
+    NODISCARD bool IsEmpty() const { return queue_.IsEmpty(); }
+
+    NODISCARD std::size_t GetSize() const { return queue_.GetSize(); }
+
+    NODISCARD int GetMinF() const { return queue_.GetMinKey(); }
+
+    NODISCARD std::optional<AStarState> PopMin(const Graph &, const Graph &, const PairLowerBounds &, int)
     {
-        assert(used_ > 0);
+        const NodeHandle handle        = queue_.PopMin();
+        std::optional<AStarState> node = std::move(pool_.Get(handle));
+        pool_.Release(handle);
+        return node;
+    }
 
-        AStarState rv = table_[0];
+    private:
+    NodePool<AStarState> pool_{};
+    BucketQueue queue_{};
+};
 
-        for (size_t idx = 0; idx < used_ - 1; ++idx) {
-            table_[idx] = table_[idx + 1];
-        }
-        used_--;
+/* Open list of AccurateAStar on top of ExternalOpenList. A node is packed into the image of every G1 vertex, all ones
+ * for the unmapped ones, in as few bytes as the size of G2 allows. A popped node is rebuilt by replaying the
+ * assignments from the root in the order PickNextVertex_ takes them, which is the order they were made in. */
+class DiskOpenList_
+{
+    public:
+    DiskOpenList_(const Graph &g1, const Graph &g2, const std::filesystem::path &scratch, const std::uint64_t memory)
+        : size_g1_(g1.GetVertices()),
+          image_bytes_(g2.GetVertices() < 0xFF ? 1 : g2.GetVertices() < 0xFFFF ? 2 : 4),
+          record_(static_cast<std::size_t>(size_g1_) * image_bytes_),
+          root_(g1, g2),
+          list_(std::make_unique<ExternalOpenList>(scratch, std::max<std::size_t>(record_.size(), 1), memory))
+    {
+    }
 
-        return rv;
+    void Push(AStarState &&node)
+    {
+        for (Vertex v1 = 0; v1 < size_g1_; ++v1) {
+            const auto image = static_cast<std::uint32_t>(node.state.mapping.get_mapping_g1_to_g2(v1));
+            for (std::size_t byte = 0; byte < image_bytes_; ++byte) {
+                record_[v1 * image_bytes_ + byte] = static_cast<std::uint8_t>(image >> (8 * byte));
+            }
+        }
+        list_->Push(node.f, record_.data());
     }
 
-    void Insert(const AStarState &state)
+    NODISCARD bool IsEmpty() const { return list_->IsEmpty(); }
+
+    NODISCARD std::size_t GetSize() const { return list_->GetSize(); }
+
+    NODISCARD int GetMinF() const { return list_->GetMinF(); }
+
+    /* Empty when the replay proves that the node cannot get below the threshold any more */
+    NODISCARD std::optional<AStarState> PopMin(
+        const Graph &g1, const Graph &g2, const PairLowerBounds &bounds, const int threshold
+    )
     {
-        if (used_ == R && state.f >= table_[used_ - 1].f) {
-            return;
+        list_->PopMin(record_.data());
+
+        const auto read_image = [&](const Vertex v1) {
+            std::uint32_t image = 0;
+            for (std::size_t byte = 0; byte < image_bytes_; ++byte) {
+                image |= static_cast<std::uint32_t>(record_[v1 * image_bytes_ + byte]) << (8 * byte);
+            }
+            return image;
+        };
+        const std::uint32_t unmapped = image_bytes_ == 4 ? UINT32_MAX : (1U << (8 * image_bytes_)) - 1;
+
+        Vertices depth = 0;
+        for (Vertex v1 = 0; v1 < g1.GetVertices(); ++v1) {
+            depth += read_image(v1) != unmapped ? 1 : 0;
         }
 
-        size_t insert_pos = used_;
-        for (size_t i = 0; i < used_; ++i) {
-            if (state.f < table_[i].f) {
-                insert_pos = i;
-                break;
+        /* Same steps as MakeChild_, the heuristic is only needed at the end */
+        std::optional<AStarState> node = root_;
+        for (Vertices step = 0; step < depth; ++step) {
+            const Vertex v1 = PickNextVertex_(g1, node->state);
+            const Vertex v2 = read_image(v1);
+            assert(v2 != unmapped);
+
+            node->g += node->domains.GetPartialCost(v1, v2);
+            if (node->g >= threshold) {
+                return std::nullopt;
+            }
+            node->state.set_mapping(v1, v2);
+            if (!node->domains.Assign(g1, g2, bounds, node->state.mapping, v1, v2, node->g, threshold)) {
+                return std::nullopt;
             }
         }
+        node->f = node->g + CalculateHeuristic_(g1, bounds, node->state, node->domains);
+        return node;
+    }
+
+    private:
+    Vertices size_g1_;
+    std::size_t image_bytes_;
+    std::vector<std::uint8_t> record_;
+    AStarState root_;
+    std::unique_ptr<ExternalOpenList> list_;
+};
+
+std::vector<Mapping> AccurateAStar(const Graph &g1, const Graph &g2, const int k, SearchContext &ctx)
+{
+    return AccurateAStarTask(g1, g2, k, ctx, 0).Run();
+}
+
+std::vector<Mapping> AccurateAStarExternal(
+    const Graph &g1, const Graph &g2, [[maybe_unused]] const int k, SearchContext &ctx,
+    const std::filesystem::path &scratch, const std::uint64_t memory_limit
+)
+{
+    return AStarSearch_(g1, g2, ctx, 0, DiskOpenList_(g1, g2, scratch, memory_limit)).Run();
+}
+
+SearchTask AccurateAStarTask(
+    const Graph &g1, const Graph &g2, [[maybe_unused]] const int k, SearchContext &ctx, const std::uint64_t slice
+)
+{
+    return AStarSearch_(g1, g2, ctx, slice, InMemoryOpenList_{});
+}
+
+// ------------------------------
+// Depth-first branch and bound
+// ------------------------------
+
+/* children[depth] holds the scored children of the current node of that depth, its slots reused by the siblings */
+static void BranchAndBoundRecursive_(
+    const Graph &g1, const Graph &g2, const PairLowerBounds &bounds, const CandidateRanking &ranking,
+    const AStarState &node, std::vector<std::vector<AStarState>> &children, const size_t depth, SearchContext &ctx
+)
+{
+    if (ctx.ShouldStop()) {
+        return;
+    }
+
+    if (node.state.mapping.get_mapped_count() == g1.GetVertices()) {
+        ctx.OfferIncumbent(node.state.mapping, node.g);
+        return;
+    }
+
+    const Vertex v1               = PickNextVertex_(g1, node.state);
+    std::vector<AStarState> &slots = children[depth];
+    if (const auto candidates = static_cast<std::size_t>(ranking.End(v1) - ranking.Begin(v1));
+        slots.size() < candidates) {
+        slots.resize(candidates);
+    }
 
-        if (used_ < R) {
-            used_++;
+    /* Score all children first so that they are explored in increasing f order, ties by candidate rank (static
+     * bound first, then colour agreement). The scored states are kept and recursed into as they are. */
+    std::vector<std::tuple<int, Vertices, std::size_t>> order;
+    for (const Vertex *it = ranking.Begin(v1); it != ranking.End(v1); ++it) {
+        const Vertex v2 = *it;
+        if (!node.domains.Contains(v1, v2) || node.g + bounds.Get(v1, v2) >= ctx.GetIncumbentCost()) {
+            continue;
         }
 
-        for (size_t i = used_ - 1; i > insert_pos; --i) {
-            table_[i] = table_[i - 1];
+        AStarState &child = slots[order.size()];
+        if (MakeChild_(g1, g2, bounds, node, v1, v2, ctx.GetIncumbentCost(), child) &&
+            child.f < ctx.GetIncumbentCost()) {
+            order.emplace_back(child.f, static_cast<Vertices>(it - ranking.Begin(v1)), order.size());
+        }
+    }
+    std::sort(order.begin(), order.end());
+
+    ctx.RecordExpansion(node.state.mapping.get_mapped_count(), order.empty() ? INT_MAX : std::get<0>(order[0]));
+    for (const auto &[f_child, rank, slot] : order) {
+        /* Children are sorted, so once one cannot beat the incumbent none of the rest can. A child scored against an
+         * older incumbent was only pruned less, its f is still a valid bound. */
+        if (f_child >= ctx.GetIncumbentCost()) {
+            break;
         }
+        BranchAndBoundRecursive_(g1, g2, bounds, ranking, slots[slot], children, depth + 1, ctx);
+    }
+}
 
-        table_[insert_pos] = state;
+std::vector<Mapping> AccurateBranchAndBound(const Graph &g1, const Graph &g2, const int k)
+{
+    SearchContext ctx{};
+    return AccurateBranchAndBound(g1, g2, k, ctx);
+}
+
+std::vector<Mapping> AccurateBranchAndBound(
+    const Graph &g1, const Graph &g2, [[maybe_unused]] const int k, SearchContext &ctx
+)
+{
+    if (g1.GetVertices() > g2.GetVertices()) {
+        return {};
     }
 
-    private:
-    AStarState table_[R]{};
-    size_t used_{0};
-};
+    const PairLowerBounds bounds(g1, g2);
+    const CandidateRanking ranking(g1, g2, bounds);
+    const AStarState root(g1, g2);
+    std::vector<std::vector<AStarState>> children(g1.GetVertices());
+
+    /* A greedy incumbent up front gives the bound something to prune against from the first level */
+    OfferGreedyCompletion_(g1, g2, bounds, root, ctx);
 
-template <std::uint32_t R>
+    BranchAndBoundRecursive_(g1, g2, bounds, ranking, root, children, 0, ctx);
+    if (!ctx.ShouldStop()) {
+        ctx.RaiseLowerBound(ctx.GetIncumbentCost());
+    }
+
+    return {*ctx.GetIncumbent()};
+}
+
+// ------------------------------
+// Approx A star
+// ------------------------------
+
+/* One beam per depth of the search tree, each holding at most width nodes and popped at most width times */
 struct MasterQueue {
-    MasterQueue(const size_t size) : state_(size), counters_(size, R) {}
+    MasterQueue(const size_t size, const std::uint32_t width) : state_(size, BeamHeap(width)), counters_(size, width) {}
 
-    NODISCARD std::uint32_t GetMinId()
+    /* Nothing when the only nodes left sit on levels that used up their pops, i.e. everything deeper was pruned */
+    NODISCARD std::optional<std::uint32_t> GetMinId()
     {
         int min               = INT_MAX;
         std::int64_t best_idx = 0;
 
         for (std::int64_t idx = highest_empty + 1; idx < static_cast<std::int64_t>(state_.size()); ++idx) {
-            if (!state_[idx].IsEmpty() && state_[idx].PeekBest().f < min) {
-                min      = state_[idx].PeekBest().f;
+            if (!state_[idx].IsEmpty() && state_[idx].PeekBestF() < min) {
+                min      = state_[idx].PeekBestF();
                 best_idx = idx;
             }
         }
 
+        if (min == INT_MAX) {
+            return std::nullopt;
+        }
+
         counters_[best_idx]--;
         if (counters_[best_idx] == 0) {
             assert(best_idx >= highest_empty);
             highest_empty = best_idx;
         }
 
-        assert(min != INT_MAX);
-        return best_idx;
+        return static_cast<std::uint32_t>(best_idx);
     }
 
-    NODISCARD PrioArr<R> &GetPrioArr(const std::uint32_t idx) { return state_[idx]; }
+    NODISCARD BeamHeap &GetBeam(const std::uint32_t idx) { return state_[idx]; }
+
+    NODISCARD size_t GetSize() const
+    {
+        size_t size = 0;
+        for (const auto &beam : state_) {
+            size += beam.Size();
+        }
+        return size;
+    }
 
     private:
-    std::vector<PrioArr<R>> state_;
+    std::vector<BeamHeap> state_;
     std::vector<std::uint32_t> counters_;
     std::int64_t highest_empty = -1;
 };
 
-template <std::uint32_t R = 1>
-NODISCARD std::vector<Mapping> ApproxAStar_(const Graph &g1, const Graph &g2, int k)
+/* Inserts the pooled node into the beam and releases whatever did not fit */
+static void InsertIntoBeam_(NodePool<AStarState> &pool, BeamHeap &beam, const NodeHandle handle)
 {
-    if (g1.GetVertices() > g2.GetVertices()) {
-        return {};
+    if (const std::optional<NodeHandle> dropped = beam.Insert(pool.Get(handle).f, handle); dropped.has_value()) {
+        pool.Release(*dropped);
     }
+}
+
+/* Share of the remaining time planned for the beam, the rest is a margin for the estimate error */
+static constexpr double kAutoBeamTimeShare = 0.8;
 
-    Vertices n1 = g1.GetVertices();
+/* Upper bound on the memory held by the nodes of an automatically sized beam */
+static constexpr std::size_t kAutoBeamMemoryBytes = std::size_t{2} << 30;
 
-    MasterQueue master_queue = MasterQueue<R>(n1);
-    const Vertex v_start     = PickNextVertex_(g1, AStarState(n1, g2.GetVertices()).state);
+static constexpr std::uint32_t kMaxAutoBeamWidth = 1 << 16;
+
+/* Levels expanded to measure the cost of a single expansion */
+static constexpr Vertices kBeamProbeLevels = 4;
+
+/* Relative work of an expansion at the given depth that fully evaluates the given number of children, each of which
+ * updates the domains of all unmapped vertices */
+static double ExpansionWork_(const Vertices n1, const Vertices n2, const Vertices depth, const double children)
+{
+    const double free_g1 = n1 - depth;
+    const double free_g2 = n2 - depth;
+    return children * free_g1 * free_g2;
+}
 
-    for (Vertex v = 0; v < g2.GetVertices(); ++v) {
-        AStarState state(n1, g2.GetVertices());
+/* Time of a unit of ExpansionWork_, measured on a greedy dive through the first levels */
+static double MeasureExpansionUnitSeconds_(
+    const Graph &g1, const Graph &g2, const PairLowerBounds &bounds, const AStarState &root
+)
+{
+    const auto start      = SearchContext::Clock::now();
+    AStarState node       = root;
+    AStarState child      = root;
+    AStarState best_child = root;
+    double work           = 0.0;
+
+    for (Vertices depth = 0; depth < kBeamProbeLevels && depth < g1.GetVertices(); ++depth) {
+        const Vertex v1 = PickNextVertex_(g1, node.state);
+        int best_f      = INT_MAX;
+
+        node.domains.IterateDomain(
+            [&](const Vertex v2) {
+                if (MakeChild_(g1, g2, bounds, node, v1, v2, INT_MAX, child) && child.f < best_f) {
+                    best_f = child.f;
+                    std::swap(best_child, child);
+                }
+            },
+            v1
+        );
 
-        state.state.set_mapping(v_start, v);
-        state.g = 0;
-        state.f = CalculateHeuristic_(g1, g2, state.state);
-        master_queue.GetPrioArr(0).Insert(state);
+        work += ExpansionWork_(g1.GetVertices(), g2.GetVertices(), depth, g2.GetVertices() - depth);
+        if (best_f == INT_MAX) {
+            break;
+        }
+        std::swap(node, best_child);
     }
 
+    const double elapsed = std::chrono::duration<double>(SearchContext::Clock::now() - start).count();
+    return elapsed / std::max(work, 1.0);
+}
+
+/* Children that get MakeChild_ per expanded node, what the first stage of the scoring leaves */
+static std::size_t ScoredChildrenLimit_(const std::uint32_t scored_children_factor, const std::uint32_t beam_width)
+{
+    return scored_children_factor == kScoreAllChildren ? SIZE_MAX : std::size_t{scored_children_factor} * beam_width;
+}
+
+/* Widest beam whose expansions, at most width per level spread over the given number of threads, fit into the
+ * remaining time and the node memory budget */
+static std::uint32_t PickAutoBeamWidth_(
+    const Graph &g1, const Graph &g2, const PairLowerBounds &bounds, const AStarState &root, const SearchContext &ctx,
+    const unsigned threads, const std::uint32_t scored_children_factor
+)
+{
+    const Vertices n1 = g1.GetVertices();
+    const Vertices n2 = g2.GetVertices();
+
+    /* Only ScoredChildrenLimit_ children of an expansion are evaluated, the work grows faster than width */
+    const auto beam_work = [&](const std::uint32_t width) {
+        const auto limit = static_cast<double>(ScoredChildrenLimit_(scored_children_factor, width));
+        double work      = 0.0;
+        for (Vertices depth = 0; depth + 1 < n1; ++depth) {
+            const double children = std::min<double>(n2 - depth, limit);
+            work += width * ExpansionWork_(n1, n2, depth, children);
+        }
+        return work;
+    };
+
+    const double node_bytes = static_cast<double>(n1) * n2 * (sizeof(int) + 0.125) + n1 * sizeof(MappedVertex) +
+                              n2 * 48.0;
+    const double by_memory = static_cast<double>(kAutoBeamMemoryBytes) / (std::max<Vertices>(n1, 1) * node_bytes);
+
+    const double unit_seconds      = MeasureExpansionUnitSeconds_(g1, g2, bounds, root);
+    const double remaining_seconds = std::chrono::duration<double>(ctx.GetTimeRemaining()).count();
+    const double work_budget       = remaining_seconds * kAutoBeamTimeShare * threads / std::max(unit_seconds, 1e-15);
+
+    /* Largest width within the memory cap whose work fits into the budget */
+    std::uint32_t low  = 1;
+    std::uint32_t high = static_cast<std::uint32_t>(std::clamp(by_memory, 1.0, static_cast<double>(kMaxAutoBeamWidth)));
+    while (low < high) {
+        const std::uint32_t mid = low + (high - low + 1) / 2;
+        if (beam_work(mid) <= work_budget) {
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return low;
+}
+
+NODISCARD std::uint32_t GetDefaultBeamWidth(const Vertices size_g2)
+{
+    if (size_g2 <= 20) {
+        return 60;
+    }
+    if (size_g2 <= 40) {
+        return 50;
+    }
+    if (size_g2 <= 60) {
+        return 30;
+    }
+    if (size_g2 <= 80) {
+        return 12;
+    }
+    if (size_g2 <= 90) {
+        return 5;
+    }
+    if (size_g2 <= 100) {
+        return 3;
+    }
+    return 1;
+}
+
+static std::uint32_t ResolveBeamWidth_(
+    const Graph &g1, const Graph &g2, const PairLowerBounds &bounds, const AStarState &root, const SearchContext &ctx,
+    const std::uint32_t beam_width, const unsigned threads,
+    const std::uint32_t scored_children_factor = kDefaultScoredChildrenFactor
+)
+{
+    if (beam_width == kDefaultBeamWidth || (beam_width == kAutoBeamWidth && !ctx.HasDeadline())) {
+        return GetDefaultBeamWidth(g2.GetVertices());
+    }
+    if (beam_width == kAutoBeamWidth) {
+        return PickAutoBeamWidth_(g1, g2, bounds, root, ctx, threads, scored_children_factor);
+    }
+    return beam_width;
+}
+
+/* Ranking behind a candidate limit of the beam engines, nothing without one. Keeps a margin of |V1| entries per
+ * vertex, as up to that many of the best ones may already be taken. */
+static std::optional<CandidateRanking> MakeBeamRanking_(
+    const Graph &g1, const Graph &g2, const PairLowerBounds &bounds, const std::uint32_t candidates
+)
+{
+    if (candidates == kAllCandidates) {
+        return std::nullopt;
+    }
+    return std::make_optional<CandidateRanking>(g1, g2, bounds, candidates + g1.GetVertices());
+}
+
+/* Children of a beam node: the first candidates entries of the ranking of v1 still in its domain, or the whole
+ * domain ordered by bound without a ranking. Falls back to the best of the domain if the ranking runs dry. */
+static std::vector<Vertex> SelectCandidates_(
+    const PairLowerBounds &bounds, const CandidateDomains &domains, const Vertex v1, const CandidateRanking *ranking,
+    const std::uint32_t candidates, std::mt19937 *generator
+)
+{
+    if (ranking == nullptr) {
+        return OrderCandidates_(bounds, domains, v1, generator);
+    }
+
+    std::vector<Vertex> selected;
+    for (const Vertex *it = ranking->Begin(v1); it != ranking->End(v1) && selected.size() < candidates; ++it) {
+        if (domains.Contains(v1, *it)) {
+            selected.push_back(*it);
+        }
+    }
+
+    if (selected.empty()) {
+        selected = OrderCandidates_(bounds, domains, v1, generator);
+        selected.resize(std::min<size_t>(selected.size(), candidates));
+    }
+    return selected;
+}
+
+/* First stage of the child scoring: keeps the limit candidates with the lowest max(partial cost, static bound), an
+ * O(1) lower bound of what v1 adds to the cost. Only those get the state copy and the heuristic of MakeChild_. */
+static void KeepCheapestCandidates_(
+    const PairLowerBounds &bounds, const CandidateDomains &domains, const Vertex v1, const std::size_t limit,
+    std::vector<Vertex> &candidates
+)
+{
+    if (candidates.size() <= limit) {
+        return;
+    }
+
+    const auto score = [&](const Vertex v2) {
+        return std::max(domains.GetPartialCost(v1, v2), bounds.Get(v1, v2));
+    };
+    std::stable_sort(candidates.begin(), candidates.end(), [&](const Vertex a, const Vertex b) {
+        return score(a) < score(b);
+    });
+    candidates.resize(limit);
+}
+
+/* Variation of a single beam run, the default is the deterministic engine */
+struct BeamVariant {
+    std::mt19937 *generator{}; /* Breaks ties between candidates with equal bound */
+    Vertices start_rank{};     /* Rank of the first G1 vertex by neighbour count */
+    std::uint32_t scored_children_factor{kDefaultScoredChildrenFactor};
+};
+
+/* Yields every slice expansions, never with 0. The arguments are referenced by the task and must outlive it. */
+static SearchTask BeamSearch_(
+    const Graph &g1, const Graph &g2, const PairLowerBounds &bounds, const CandidateRanking *ranking,
+    const std::uint32_t candidates, const AStarState &root, SearchContext &ctx, const std::uint32_t beam_width,
+    const BeamVariant &variant, const std::uint64_t slice
+)
+{
+    const Vertices n1 = g1.GetVertices();
+
+    /* Nodes live in the pool, the beams only move (f, handle) pairs around */
+    NodePool<AStarState> pool;
+    MasterQueue master_queue(n1, beam_width);
+    const Vertex v_start = PickNextVertex_(g1, root.state, variant.start_rank);
+
+    for (const Vertex v : SelectCandidates_(bounds, root.domains, v_start, ranking, candidates, variant.generator)) {
+        const NodeHandle handle = pool.Acquire();
+        if (MakeChild_(g1, g2, bounds, root, v_start, v, ctx.GetIncumbentCost(), pool.Get(handle))) {
+            InsertIntoBeam_(pool, master_queue.GetBeam(0), handle);
+        } else {
+            pool.Release(handle);
+        }
+    }
+
+    BeamHeap children(beam_width);
+    std::uint64_t steps = 0;
     while (true) {
-        std::uint32_t idx         = master_queue.GetMinId();
-        PrioArr<R> &best_prio_arr = master_queue.GetPrioArr(idx);
-        AStarState best_state     = best_prio_arr.GetBest();
+        /* Everything was pruned against the incumbent, found outside or by another run */
+        const std::optional<std::uint32_t> min_id = master_queue.GetMinId();
+        if (!min_id.has_value()) {
+            auto incumbent = ctx.GetIncumbent();
+            co_return incumbent.has_value() ? std::vector<Mapping>{*incumbent} : std::vector<Mapping>{};
+        }
+
+        const std::uint32_t idx      = *min_id;
+        const NodeHandle best_handle = master_queue.GetBeam(idx).PopBest();
+        const AStarState &best_state = pool.Get(best_handle);
+
+        /* f is the smallest bound left in the beam: nothing here can beat the incumbent, e.g. of another worker */
+        if (best_state.f >= ctx.GetIncumbentCost()) {
+            co_return std::vector<Mapping>{*ctx.GetIncumbent()};
+        }
 
         if (idx == n1 - 1) {
-            return {best_state.state.mapping};
+            ctx.OfferIncumbent(best_state.state.mapping, best_state.g);
+            co_return std::vector<Mapping>{best_state.state.mapping};
         }
 
-        Vertex next_vertex = PickNextVertex_(g1, best_state.state);
-        PrioArr<R> candidates;
-        for (Vertex mapping_candidate : best_state.state.availableVertices) {
-            AStarState next_state;
-            next_state.state = best_state.state;
-            next_state.state.set_mapping(next_vertex, mapping_candidate);
+        /* Interrupted: finish the current beam state greedily instead of losing the work */
+        if (ctx.ShouldStop()) {
+            OfferGreedyCompletion_(g1, g2, bounds, best_state, ctx);
+            co_return std::vector<Mapping>{*ctx.GetIncumbent()};
+        }
+        ctx.RecordExpansion(master_queue.GetSize(), best_state.f);
+
+        const Vertex next_vertex = PickNextVertex_(g1, best_state.state);
+        std::vector<Vertex> selected =
+            SelectCandidates_(bounds, best_state.domains, next_vertex, ranking, candidates, variant.generator);
+        KeepCheapestCandidates_(
+            bounds, best_state.domains, next_vertex, ScoredChildrenLimit_(variant.scored_children_factor, beam_width),
+            selected
+        );
 
-            const int cost_increment =
-                CalculateAssignmentCost_(g1, g2, best_state.state.mapping, next_vertex, mapping_candidate);
-            next_state.g = best_state.g + cost_increment;
+        for (const Vertex mapping_candidate : selected) {
+            /* f >= g + partial cost, so a child that cannot enter the full beam needs no heuristic at all */
+            const int g_child = best_state.g + best_state.domains.GetPartialCost(next_vertex, mapping_candidate);
+            if (children.IsFull() && g_child >= children.PeekWorstF()) {
+                continue;
+            }
 
-            const int h  = CalculateHeuristic_(g1, g2, next_state.state);
-            next_state.f = next_state.g + h;
+            const NodeHandle handle = pool.Acquire();
+            if (MakeChild_(
+                    g1, g2, bounds, best_state, next_vertex, mapping_candidate, ctx.GetIncumbentCost(),
+                    pool.Get(handle)
+                )) {
+                InsertIntoBeam_(pool, children, handle);
+            } else {
+                pool.Release(handle);
+            }
+        }
+        pool.Release(best_handle);
 
-            candidates.Insert(next_state);
+        BeamHeap &next_beam = master_queue.GetBeam(idx + 1);
+        while (!children.IsEmpty()) {
+            InsertIntoBeam_(pool, next_beam, children.PopBest());
         }
 
-        PrioArr<R> &next_prio_arr = master_queue.GetPrioArr(idx + 1);
-        while (!candidates.IsEmpty()) {
-            next_prio_arr.Insert(candidates.GetBest());
+        if (slice != 0 && ++steps % slice == 0) {
+            co_yield SearchYield{};
         }
     }
+}
+
+static SearchTask ApproxAStarTask_(
+    const Graph &g1, const Graph &g2, [[maybe_unused]] int k, SearchContext &ctx, std::uint32_t beam_width,
+    const std::uint32_t candidates, const std::uint32_t scored_children_factor, const std::uint64_t slice
+)
+{
+    if (g1.GetVertices() > g2.GetVertices()) {
+        co_return std::vector<Mapping>{};
+    }
 
-    return {};
+    const PairLowerBounds bounds(g1, g2);
+    const std::optional<CandidateRanking> ranking = MakeBeamRanking_(g1, g2, bounds, candidates);
+    const AStarState root(g1, g2);
+    const BeamVariant variant{nullptr, 0, scored_children_factor};
+    beam_width = ResolveBeamWidth_(g1, g2, bounds, root, ctx, beam_width, 1, scored_children_factor);
+
+    /* The beam refers to the locals above, which live in this frame for as long as it runs */
+    SearchTask beam =
+        BeamSearch_(g1, g2, bounds, ranking ? &*ranking : nullptr, candidates, root, ctx, beam_width, variant, slice);
+    while (!beam.Resume()) {
+        co_yield SearchYield{};
+    }
+    co_return beam.TakeResult();
 }
 
-NODISCARD std::vector<Mapping> ApproxAStar(const Graph &g1, const Graph &g2, int k)
+static std::vector<Mapping> ApproxAStar_(
+    const Graph &g1, const Graph &g2, int k, SearchContext &ctx, std::uint32_t beam_width,
+    const std::uint32_t candidates = kAllCandidates,
+    const std::uint32_t scored_children_factor = kDefaultScoredChildrenFactor
+)
+{
+    return ApproxAStarTask_(g1, g2, k, ctx, beam_width, candidates, scored_children_factor, 0).Run();
+}
+
+SearchTask ApproxAStarTask(
+    const Graph &g1, const Graph &g2, int k, SearchContext &ctx, std::uint32_t beam_width,
+    const std::uint32_t candidates, const std::uint64_t slice
+)
+{
+    return ApproxAStarTask_(g1, g2, k, ctx, beam_width, candidates, kDefaultScoredChildrenFactor, slice);
+}
+
+// ------------------------------
+// Multi-start approx A star
+// ------------------------------
+
+/* Start vertices of the randomised runs are drawn from this many of the highest-degree G1 vertices */
+static constexpr Vertices kMultiStartVertexRanks = 4;
+
+/* Beam widths of the randomised runs are drawn from [width / kMultiStartWidthSpread, width * kMultiStartWidthSpread] */
+static constexpr std::uint32_t kMultiStartWidthSpread = 2;
+
+NODISCARD std::vector<Mapping> ApproxAStarMultiStart(
+    const Graph &g1, const Graph &g2, [[maybe_unused]] int k, SearchContext &ctx, std::uint32_t beam_width,
+    const unsigned threads, const std::uint32_t candidates
+)
 {
-    if (g2.GetVertices() <= 20) {
-        return ApproxAStar_<60>(g1, g2, k);
+    if (g1.GetVertices() > g2.GetVertices()) {
+        return {};
     }
-    if (g2.GetVertices() <= 40) {
-        return ApproxAStar_<50>(g1, g2, k);
+
+    /* No start vertex to draw, the empty mapping is the only one */
+    if (g1.GetVertices() == 0) {
+        return {Mapping(0, g2.GetVertices())};
     }
-    if (g2.GetVertices() <= 60) {
-        return ApproxAStar_<30>(g1, g2, k);
+
+    const unsigned workers = std::max(threads, 1U);
+    const PairLowerBounds bounds(g1, g2);
+    const std::optional<CandidateRanking> ranking = MakeBeamRanking_(g1, g2, bounds, candidates);
+    const CandidateRanking *ranking_ptr           = ranking ? &*ranking : nullptr;
+    const AStarState root(g1, g2);
+    beam_width = ResolveBeamWidth_(g1, g2, bounds, root, ctx, beam_width, 1);
+
+    /* The first run of worker 0 is the deterministic engine, so the result is never worse than ApproxAStar with the
+     * same width. Every other run is randomised from the RNG stream of its worker. With a deadline the workers keep
+     * restarting until it expires, the incumbent they share prunes the runs that cannot improve on it. */
+    const auto run_worker = [&](const unsigned worker) {
+        std::mt19937 generator(kSeed + worker);
+        std::uniform_int_distribution<Vertices> pick_rank(0, std::min(kMultiStartVertexRanks, g1.GetVertices()) - 1);
+        std::uniform_int_distribution<std::uint32_t> pick_width(
+            std::max(beam_width / kMultiStartWidthSpread, 1U), std::max(beam_width, beam_width * kMultiStartWidthSpread)
+        );
+
+        if (worker == 0) {
+            (void)BeamSearch_(g1, g2, bounds, ranking_ptr, candidates, root, ctx, beam_width, BeamVariant{}, 0).Run();
+            if (!ctx.HasDeadline()) {
+                return;
+            }
+        }
+
+        while (!ctx.ShouldStop() && !ctx.IsIncumbentProvenOptimal()) {
+            const BeamVariant variant{&generator, pick_rank(generator)};
+            const std::uint32_t width = pick_width(generator);
+            (void)BeamSearch_(g1, g2, bounds, ranking_ptr, candidates, root, ctx, width, variant, 0).Run();
+
+            if (!ctx.HasDeadline()) {
+                return;
+            }
+        }
+    };
+
+    /* The calling thread works as worker 0 */
+    TaskGroup team(GetSharedThreadPool());
+    for (unsigned worker = 1; worker < workers; ++worker) {
+        team.Run([&run_worker, worker] {
+            run_worker(worker);
+        });
     }
-    if (g2.GetVertices() <= 80) {
-        return ApproxAStar_<12>(g1, g2, k);
+    run_worker(0);
+    team.Wait();
+
+    auto incumbent = ctx.GetIncumbent();
+    return incumbent.has_value() ? std::vector<Mapping>{*incumbent} : std::vector<Mapping>{};
+}
+
+// ------------------------------
+// Parallel approx A star
+// ------------------------------
+
+NODISCARD std::vector<Mapping> ApproxAStarParallel(
+    const Graph &g1, const Graph &g2, [[maybe_unused]] int k, SearchContext &ctx, std::uint32_t beam_width,
+    const unsigned threads, const std::uint32_t candidates
+)
+{
+    if (g1.GetVertices() > g2.GetVertices()) {
+        return {};
     }
 
-    if (g2.GetVertices() <= 90) {
-        return ApproxAStar_<5>(g1, g2, k);
+    const Vertices n1      = g1.GetVertices();
+    const unsigned workers = std::max(threads, 1U);
+    const PairLowerBounds bounds(g1, g2);
+    const std::optional<CandidateRanking> ranking = MakeBeamRanking_(g1, g2, bounds, candidates);
+
+    std::vector<AStarState> level;
+    std::vector<AStarState> next_level;
+    level.emplace_back(g1, g2);
+    beam_width = ResolveBeamWidth_(g1, g2, bounds, level[0], ctx, beam_width, workers);
+
+    /* Every (parent, candidate) pair of a level gets a flat index: parents in beam order, candidates in bound order.
+     * Workers take contiguous index ranges and the index breaks ties on f, so the next level does not depend on the
+     * way the range was split. */
+    std::vector<std::pair<std::uint32_t, Vertex>> pairs;
+    std::vector<Vertex> next_vertices;
+
+    std::vector<NodePool<AStarState>> pools(workers);
+    std::vector<BeamHeap> beams(workers, BeamHeap(beam_width));
+
+    const auto expand_range = [&](const unsigned worker) {
+        const size_t begin         = pairs.size() * worker / workers;
+        const size_t end           = pairs.size() * (worker + 1) / workers;
+        NodePool<AStarState> &pool = pools[worker];
+        BeamHeap &beam             = beams[worker];
+
+        for (size_t idx = begin; idx < end && !ctx.ShouldStop(); ++idx) {
+            const auto [parent_idx, v2] = pairs[idx];
+            const AStarState &parent    = level[parent_idx];
+            const Vertex v1             = next_vertices[parent_idx];
+
+            /* f >= g + partial cost, so a child that cannot enter the full beam needs no heuristic at all */
+            if (beam.IsFull() && parent.g + parent.domains.GetPartialCost(v1, v2) >= beam.PeekWorstF()) {
+                continue;
+            }
+
+            const NodeHandle handle = pool.Acquire();
+            if (!MakeChild_(g1, g2, bounds, parent, v1, v2, ctx.GetIncumbentCost(), pool.Get(handle))) {
+                pool.Release(handle);
+                continue;
+            }
+            if (const auto dropped = beam.Insert(pool.Get(handle).f, idx, handle); dropped.has_value()) {
+                pool.Release(*dropped);
+            }
+        }
+    };
+
+    for (Vertices depth = 0; depth < n1 && !level.empty(); ++depth) {
+        /* Interrupted: finish the best state of the level greedily instead of losing the work */
+        if (ctx.ShouldStop()) {
+            OfferGreedyCompletion_(g1, g2, bounds, level[0], ctx);
+            level.clear();
+            break;
+        }
+
+        pairs.clear();
+        next_vertices.clear();
+        for (std::uint32_t parent_idx = 0; parent_idx < level.size(); ++parent_idx) {
+            const Vertex v1 = PickNextVertex_(g1, level[parent_idx].state);
+            next_vertices.push_back(v1);
+
+            const CandidateDomains &domains = level[parent_idx].domains;
+            std::vector<Vertex> selected =
+                SelectCandidates_(bounds, domains, v1, ranking ? &*ranking : nullptr, candidates, nullptr);
+            KeepCheapestCandidates_(
+                bounds, domains, v1, ScoredChildrenLimit_(kDefaultScoredChildrenFactor, beam_width), selected
+            );
+            for (const Vertex v2 : selected) {
+                pairs.emplace_back(parent_idx, v2);
+            }
+        }
+
+        /* One task per worker range, so the split and with it the next level do not depend on the pool size */
+        GetSharedThreadPool().ParallelFor(0, workers, 1, [&](const std::size_t worker, std::size_t) {
+            expand_range(static_cast<unsigned>(worker));
+        });
+
+        /* Every parent of the level was expanded, unless a stop cut the level short */
+        if (!ctx.ShouldStop()) {
+            for (const AStarState &parent : level) {
+                ctx.RecordExpansion(level.size(), parent.f);
+            }
+        }
+
+        /* k-way merge of the sorted worker beams into the next level, moving the nodes out of the pools */
+        next_level.resize(beam_width);
+        size_t taken = 0;
+        while (taken < beam_width) {
+            std::optional<unsigned> best{};
+            for (unsigned worker = 0; worker < workers; ++worker) {
+                if (beams[worker].IsEmpty()) {
+                    continue;
+                }
+                if (!best.has_value() || beams[worker].PeekBestF() < beams[*best].PeekBestF() ||
+                    (beams[worker].PeekBestF() == beams[*best].PeekBestF() &&
+                     beams[worker].PeekBestOrder() < beams[*best].PeekBestOrder())) {
+                    best = worker;
+                }
+            }
+            if (!best.has_value()) {
+                break;
+            }
+
+            const NodeHandle handle = beams[*best].PopBest();
+            std::swap(next_level[taken++], pools[*best].Get(handle));
+            pools[*best].Release(handle);
+        }
+        next_level.resize(taken);
+
+        for (unsigned worker = 0; worker < workers; ++worker) {
+            while (!beams[worker].IsEmpty()) {
+                pools[worker].Release(beams[worker].PopBest());
+            }
+        }
+        std::swap(level, next_level);
     }
 
-    if (g2.GetVertices() <= 100) {
-        return ApproxAStar_<3>(g1, g2, k);
+    if (!level.empty()) {
+        ctx.OfferIncumbent(level[0].state.mapping, level[0].g);
+        return {level[0].state.mapping};
     }
 
-    return ApproxAStar_<1>(g1, g2, k);
+    /* Everything was pruned against an incumbent provided from outside, or the search was interrupted */
+    auto incumbent = ctx.GetIncumbent();
+    return incumbent.has_value() ? std::vector<Mapping>{*incumbent} : std::vector<Mapping>{};
+}
+
+NODISCARD std::vector<Mapping> ApproxAStar(const Graph &g1, const Graph &g2, int k)
+{
+    SearchContext ctx{};
+    return ApproxAStar(g1, g2, k, ctx);
+}
+
+NODISCARD std::vector<Mapping> ApproxAStar(const Graph &g1, const Graph &g2, int k, SearchContext &ctx)
+{
+    return ApproxAStar_(g1, g2, k, ctx, kDefaultBeamWidth);
+}
+
+NODISCARD std::vector<Mapping> ApproxAStar(
+    const Graph &g1, const Graph &g2, int k, SearchContext &ctx, const std::uint32_t beam_width,
+    const std::uint32_t candidates, const std::uint32_t scored_children_factor
+)
+{
+    return ApproxAStar_(g1, g2, k, ctx, beam_width, candidates, scored_children_factor);
 }
 
 NODISCARD std::vector<Mapping> ApproxAStar5(const Graph &g1, const Graph &g2, int k)
 {
-    return ApproxAStar_<5>(g1, g2, k);
+    SearchContext ctx{};
+    return ApproxAStar5(g1, g2, k, ctx);
+}
+
+NODISCARD std::vector<Mapping> ApproxAStar5(const Graph &g1, const Graph &g2, int k, SearchContext &ctx)
+{
+    return ApproxAStar_(g1, g2, k, ctx, 5);
 }
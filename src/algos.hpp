@@ -3,7 +3,11 @@
 
 #include "State.hpp"
 #include "graph.hpp"
+#include "search_context.hpp"
+#include "search_task.hpp"
 
+#include <cstdint>
+#include <filesystem>
 #include <vector>
 
 struct EdgeExtension {
@@ -18,19 +22,119 @@ struct EdgeExtension {
 NODISCARD std::vector<EdgeExtension> GetMinimalEdgeExtension(const Graph &g1, const Graph &g2, const Mapping &mapping);
 NODISCARD Graph GetMinimalExtension(const Graph &g1, const Graph &g2, const Mapping &mapping);
 
+/* Beam width of the approximate engine. kDefaultBeamWidth takes it from the size of G2, kAutoBeamWidth measures the
+ * cost of an expansion and takes the widest beam that fits into the deadline of the context (default without one). */
+static constexpr std::uint32_t kDefaultBeamWidth = 0;
+static constexpr std::uint32_t kAutoBeamWidth    = UINT32_MAX;
+
+NODISCARD std::uint32_t GetDefaultBeamWidth(Vertices size_g2);
+
+/* Children per expanded beam node. kAllCandidates expands every free G2 vertex, a limit takes the best ones by static
+ * bound and colour refinement (see CandidateRanking). */
+static constexpr std::uint32_t kAllCandidates = 0;
+
+/* Children of an expanded beam node that get the state copy and the full heuristic, as a multiple of the beam width.
+ * The others are cut by a cheap lower bound first, kScoreAllChildren evaluates every candidate. */
+static constexpr std::uint32_t kDefaultScoredChildrenFactor = 3;
+static constexpr std::uint32_t kScoreAllChildren            = 0;
+
+/* Every engine has an overload taking a SearchContext, which adds deadline, cancellation, incumbent sharing and
+ * progress reporting. On stop the engines return their best (greedily completed) mapping. */
 NODISCARD std::vector<Mapping> AccurateBruteForce(const Graph &g1, const Graph &g2, int k);
+NODISCARD std::vector<Mapping> AccurateBruteForce(const Graph &g1, const Graph &g2, int k, SearchContext &ctx);
 NODISCARD std::vector<Mapping> AccurateAStar(const Graph &g1, const Graph &g2, int k);
+NODISCARD std::vector<Mapping> AccurateAStar(const Graph &g1, const Graph &g2, int k, SearchContext &ctx);
+/* AccurateAStar for instances whose open list outgrows the memory. Nodes are packed into the image of every G1 vertex
+ * and grouped by f, the buckets of the highest f spill to files under scratch once the list holds more than
+ * memory_limit bytes (see ExternalOpenList). A popped node is rebuilt by replaying its assignments. */
+NODISCARD std::vector<Mapping> AccurateAStarExternal(
+    const Graph &g1, const Graph &g2, int k, SearchContext &ctx, const std::filesystem::path &scratch,
+    std::uint64_t memory_limit
+);
+NODISCARD std::vector<Mapping> AccurateBranchAndBound(const Graph &g1, const Graph &g2, int k);
+NODISCARD std::vector<Mapping> AccurateBranchAndBound(const Graph &g1, const Graph &g2, int k, SearchContext &ctx);
 NODISCARD std::vector<Mapping> ApproxAStar(const Graph &g1, const Graph &g2, int k);
+NODISCARD std::vector<Mapping> ApproxAStar(const Graph &g1, const Graph &g2, int k, SearchContext &ctx);
+NODISCARD std::vector<Mapping> ApproxAStar(
+    const Graph &g1, const Graph &g2, int k, SearchContext &ctx, std::uint32_t beam_width,
+    std::uint32_t candidates = kAllCandidates, std::uint32_t scored_children_factor = kDefaultScoredChildrenFactor
+);
+
+/* Resumable forms of AccurateAStar and ApproxAStar. The task does nothing until resumed and yields every slice
+ * expansions, 0 runs it to the end in one go. The graphs and the context must outlive it. See SearchScheduler. */
+NODISCARD SearchTask AccurateAStarTask(
+    const Graph &g1, const Graph &g2, int k, SearchContext &ctx, std::uint64_t slice = kDefaultSearchSlice
+);
+NODISCARD SearchTask ApproxAStarTask(
+    const Graph &g1, const Graph &g2, int k, SearchContext &ctx, std::uint32_t beam_width = kDefaultBeamWidth,
+    std::uint32_t candidates = kAllCandidates, std::uint64_t slice = kDefaultSearchSlice
+);
+
+/* Level-synchronous beam: all states of a level are expanded across the given number of threads and the per-thread
+ * beams are merged. For a given beam width the result does not depend on the number of threads. */
+NODISCARD std::vector<Mapping> ApproxAStarParallel(
+    const Graph &g1, const Graph &g2, int k, SearchContext &ctx, std::uint32_t beam_width, unsigned threads,
+    std::uint32_t candidates = kAllCandidates
+);
+
+/* Randomised multi-start beam: every thread runs whole beam searches with its own RNG stream, which breaks ties
+ * between candidates and varies the start vertex and the beam width. With a deadline the threads restart until it
+ * expires, without one each runs once. The shared incumbent stops runs whose bound cannot improve on it. */
+NODISCARD std::vector<Mapping> ApproxAStarMultiStart(
+    const Graph &g1, const Graph &g2, int k, SearchContext &ctx, std::uint32_t beam_width, unsigned threads,
+    std::uint32_t candidates = kAllCandidates
+);
+
+/* Simulated annealing over complete mappings for instances too large for the tree search. Starts from the incumbent
+ * of the context or from a degree-ranked greedy mapping and runs until the deadline, or for a fixed number of moves
+ * per G1 vertex without one. Memory is O(|V1| + |V2| + |E1|) on top of the graphs. Returns a single mapping. */
+NODISCARD std::vector<Mapping> ApproxAnnealing(const Graph &g1, const Graph &g2, int k);
+NODISCARD std::vector<Mapping> ApproxAnnealing(const Graph &g1, const Graph &g2, int k, SearchContext &ctx);
+
+/* Greedy construction for large sparse instances. A G1 vertex with mapped neighbours only considers the free G2
+ * neighbours of their images, so a step costs O(degree) after an O(|V|^2) pass that compresses both adjacency
+ * matrices, G2 not included when it is a registered host. The first vertex of every G1 component takes the
+ * highest-degree free G2 vertex. Returns a single mapping. */
+NODISCARD std::vector<Mapping> ApproxFrontier(const Graph &g1, const Graph &g2, int k);
+NODISCARD std::vector<Mapping> ApproxFrontier(const Graph &g1, const Graph &g2, int k, SearchContext &ctx);
+
+/* Races an exact engine (A*, or DFBnB when branch_and_bound is set) against the approximate ones on a second
+ * thread. They share the incumbent of the context: approximate mappings tighten the pruning of the exact search, and
+ * once the exact lower bound meets the incumbent both sides stop. Returns a single mapping. */
+NODISCARD std::vector<Mapping> AccuratePortfolio(const Graph &g1, const Graph &g2, int k);
+NODISCARD std::vector<Mapping> AccuratePortfolio(
+    const Graph &g1, const Graph &g2, int k, SearchContext &ctx, bool branch_and_bound
+);
+
 NODISCARD std::vector<Mapping> ApproxAStar5(const Graph &g1, const Graph &g2, int k);
+NODISCARD std::vector<Mapping> ApproxAStar5(const Graph &g1, const Graph &g2, int k, SearchContext &ctx);
 
 NODISCARD inline std::vector<Mapping> Accurate(const Graph &g1, const Graph &g2, const int k)
 {
     return AccurateAStar(g1, g2, k);
 }
 
+NODISCARD inline std::vector<Mapping> Accurate(const Graph &g1, const Graph &g2, const int k, SearchContext &ctx)
+{
+    return AccurateAStar(g1, g2, k, ctx);
+}
+
 NODISCARD inline std::vector<Mapping> Approximate(const Graph &g1, const Graph &g2, const int k)
 {
     return ApproxAStar(g1, g2, k);
 }
 
+NODISCARD inline std::vector<Mapping> Approximate(const Graph &g1, const Graph &g2, const int k, SearchContext &ctx)
+{
+    return ApproxAStar(g1, g2, k, ctx);
+}
+
+NODISCARD inline std::vector<Mapping> Approximate(
+    const Graph &g1, const Graph &g2, const int k, SearchContext &ctx, const std::uint32_t beam_width,
+    const std::uint32_t candidates = kAllCandidates
+)
+{
+    return ApproxAStar(g1, g2, k, ctx, beam_width, candidates);
+}
+
 #endif  // ALGOS_HPP
@@ -0,0 +1,208 @@
+#include "algos.hpp"
+#include "host_index.hpp"
+#include "local_search.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <vector>
+
+// ------------------------------
+// Annealing schedule
+// ------------------------------
+
+/* Without a deadline the run is bounded by a number of proposed moves per G1 vertex */
+static constexpr std::uint64_t kAnnealMovesPerVertex = 2000;
+static constexpr std::uint64_t kMinAnnealMoves       = 100000;
+
+/* Moves between two checks of the context and two updates of the temperature */
+static constexpr std::uint64_t kAnnealCheckInterval = 256;
+
+/* Samples of uphill deltas used to pick the initial temperature, which accepts an average one with probability 1/2 */
+static constexpr std::uint32_t kTemperatureSamples = 256;
+
+/* The temperature decays geometrically down to this fraction of the initial one */
+static constexpr double kFinalTemperatureRatio = 1e-3;
+static constexpr double kMinTemperature        = 1e-2;
+
+// ------------------------------
+// Helpers
+// ------------------------------
+
+/* Greedy seed in O(n log n) on top of the degree computation: the i-th heaviest G1 vertex goes onto the i-th
+ * heaviest G2 vertex. The O(n1 * n2) greedy of the tree search does not scale to thousands of vertices. */
+static Mapping DegreeRankSeed_(const Graph &g1, const Graph &g2)
+{
+    const std::vector<Vertex> order_g1 = SortByDegreeDescending(ComputeWeightedDegrees(g1));
+    const std::vector<Vertex> order_g2 = SortByDegreeDescending(ComputeWeightedDegrees(g2));
+
+    Mapping mapping(g1.GetVertices(), g2.GetVertices());
+    for (Vertex i = 0; i < g1.GetVertices(); ++i) {
+        mapping.set_mapping(order_g1[i], order_g2[i]);
+    }
+    return mapping;
+}
+
+/* Proposes a random move of a random G1 vertex: reassignment onto a free G2 vertex or a swap with its owner.
+ * Returns false when there is nothing to move. */
+static bool ProposeMove_(
+    const MoveEvaluator &evaluator, const Graph &g1, const Graph &g2, std::mt19937 &generator, Vertex &v1, Vertex &u2,
+    int &delta
+)
+{
+    std::uniform_int_distribution<Vertex> pick_g1(0, g1.GetVertices() - 1);
+    std::uniform_int_distribution<Vertex> pick_g2(0, g2.GetVertices() - 1);
+
+    v1 = pick_g1(generator);
+    u2 = pick_g2(generator);
+    if (u2 == evaluator.GetImage(v1)) {
+        return false;
+    }
+
+    const MappedVertex owner = evaluator.GetOwner(u2);
+    delta = owner == kUnmappedVertex ? evaluator.ReassignDelta(v1, u2)
+                                     : evaluator.SwapDelta(v1, static_cast<Vertex>(owner));
+    return true;
+}
+
+static void ApplyMove_(MoveEvaluator &evaluator, const Vertex v1, const Vertex u2)
+{
+    if (const MappedVertex owner = evaluator.GetOwner(u2); owner == kUnmappedVertex) {
+        evaluator.Reassign(v1, u2);
+    } else {
+        evaluator.Swap(v1, static_cast<Vertex>(owner));
+    }
+}
+
+static double CalibrateTemperature_(
+    const MoveEvaluator &evaluator, const Graph &g1, const Graph &g2, std::mt19937 &generator
+)
+{
+    double uphill_sum     = 0.0;
+    std::uint32_t uphills = 0;
+    for (std::uint32_t sample = 0; sample < kTemperatureSamples; ++sample) {
+        Vertex v1{};
+        Vertex u2{};
+        int delta{};
+        if (ProposeMove_(evaluator, g1, g2, generator, v1, u2, delta) && delta > 0) {
+            uphill_sum += delta;
+            ++uphills;
+        }
+    }
+
+    if (uphills == 0) {
+        return 1.0;
+    }
+    return std::max(kMinTemperature, uphill_sum / uphills / std::log(2.0));
+}
+
+// ------------------------------
+// Implementations
+// ------------------------------
+
+std::vector<Mapping> ApproxAnnealing(const Graph &g1, const Graph &g2, const int k)
+{
+    SearchContext ctx{};
+    return ApproxAnnealing(g1, g2, k, ctx);
+}
+
+std::vector<Mapping> ApproxAnnealing(const Graph &g1, const Graph &g2, const int k, SearchContext &ctx)
+{
+    assert(k >= 1);
+
+    if (g1.GetVertices() > g2.GetVertices()) {
+        return {};
+    }
+
+    if (g1.GetVertices() == 0) {
+        return {Mapping(0, g2.GetVertices())};
+    }
+
+    std::optional<Mapping> seed = ctx.GetIncumbent();
+    if (!seed || seed->get_mapped_count() != g1.GetVertices()) {
+        seed = DegreeRankSeed_(g1, g2);
+    }
+
+    std::mt19937 generator(kSeed);
+    MoveEvaluator evaluator(g1, g2, *seed);
+
+    int cost      = evaluator.TotalCost();
+    int best_cost = cost;
+    std::vector<Vertex> best_images(g1.GetVertices());
+
+    /* The best mapping is copied out lazily, only before the walk leaves it by an uphill move */
+    bool at_best = true;
+    const auto save_best = [&] {
+        for (Vertex v1 = 0; v1 < g1.GetVertices(); ++v1) {
+            best_images[v1] = evaluator.GetImage(v1);
+        }
+        at_best = false;
+    };
+
+    const double initial_temperature = CalibrateTemperature_(evaluator, g1, g2, generator);
+    const double final_temperature   = std::max(kMinTemperature, initial_temperature * kFinalTemperatureRatio);
+    const std::uint64_t move_budget =
+        std::max(kMinAnnealMoves, kAnnealMovesPerVertex * static_cast<std::uint64_t>(g1.GetVertices()));
+
+    const SearchContext::Clock::time_point start = SearchContext::Clock::now();
+    const double time_budget                     = std::chrono::duration<double>(ctx.GetTimeRemaining()).count();
+
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    double temperature = initial_temperature;
+    for (std::uint64_t moves = 0; best_cost > 0; ++moves) {
+        if (moves % kAnnealCheckInterval == 0) {
+            if (ctx.ShouldStop()) {
+                break;
+            }
+            ctx.RecordExpansion(0, best_cost);
+
+            /* Progress through the run: elapsed share of the deadline, or of the move budget without one */
+            double progress = static_cast<double>(moves) / static_cast<double>(move_budget);
+            if (ctx.HasDeadline()) {
+                const double elapsed = std::chrono::duration<double>(SearchContext::Clock::now() - start).count();
+                progress             = time_budget > 0.0 ? elapsed / time_budget : 1.0;
+            } else if (moves >= move_budget) {
+                break;
+            }
+            temperature =
+                initial_temperature * std::pow(final_temperature / initial_temperature, std::min(progress, 1.0));
+        }
+
+        Vertex v1{};
+        Vertex u2{};
+        int delta{};
+        if (!ProposeMove_(evaluator, g1, g2, generator, v1, u2, delta)) {
+            continue;
+        }
+        if (delta > 0 && unit(generator) >= std::exp(-delta / temperature)) {
+            continue;
+        }
+
+        if (at_best && delta > 0) {
+            save_best();
+        }
+
+        ApplyMove_(evaluator, v1, u2);
+        cost += delta;
+        if (cost < best_cost || (cost == best_cost && at_best)) {
+            best_cost = cost;
+            at_best   = true;
+        }
+    }
+    if (at_best) {
+        save_best();
+    }
+
+    Mapping best(g1.GetVertices(), g2.GetVertices());
+    for (Vertex v1 = 0; v1 < g1.GetVertices(); ++v1) {
+        best.set_mapping(v1, best_images[v1]);
+    }
+    assert(best_cost == CalculateMappingCost(g1, g2, best));
+
+    ctx.OfferIncumbent(best, best_cost);
+    return {best};
+}
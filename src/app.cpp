@@ -2,16 +2,42 @@
 
 #include "algos.hpp"
 #include "curated_gen.hpp"
+#include "external_open_list.hpp"
+#include "host_index.hpp"
 #include "io.hpp"
+#include "local_search.hpp"
 #include "random_gen.hpp"
+#include "result_cache.hpp"
+#include "search_scheduler.hpp"
 #include "test_framework.hpp"
+#include "thread_pool.hpp"
 #include "trace.hpp"
 
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
 #include <chrono>
+#include <climits>
+#include <csignal>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -21,6 +47,9 @@
 
 AppState g_AppState{};
 
+/* Solve currently in flight, used by the signal handlers */
+static SearchContext *g_ActiveSearch = nullptr;
+
 // ------------------------------
 // Statics
 // ------------------------------
@@ -32,7 +61,57 @@ static void Help_()
               << "  --help                 Display this help message and exit.\n"
               << "  --approx               Run the approximate algorithm instead of the precise algorithm.\n"
               << "  --bruteforce           Run the bruteforce accurate algorithm.\n"
+              << "  --bnb                  Run the depth-first branch and bound accurate algorithm. Memory holds the\n"
+              << "                         scored children of every node on the current path (no open list).\n"
+              << "  --portfolio            Race the precise algorithm (DFBnB with --bnb) against the approximate\n"
+              << "                         ones, stopping once the best mapping is proven optimal.\n"
+              << "  --anneal               Run simulated annealing, meant for graphs with thousands of vertices.\n"
+              << "                         Uses --time-limit as its run time when given.\n"
+              << "  --frontier             Run the greedy that draws candidates from the neighbourhood of the mapped\n"
+              << "                         vertices, meant for large sparse graphs. With --anneal it seeds annealing.\n"
               << "  --gen-suite            Generate a curated suite of benchmark graph pairs to 'tests/' directory.\n"
+              << "  --time-limit <ms>      Stop the search after <ms> and output the best mapping found.\n"
+              << "                         The exact search becomes anytime: it keeps improving a feasible mapping\n"
+              << "                         until the deadline.\n"
+              << "  --beam <N|auto>        Beam width of the approximate algorithm. 'auto' measures the cost of an\n"
+              << "                         expansion and picks the widest beam that fits into --time-limit.\n"
+              << "                         Defaults to a width based on the size of G2.\n"
+              << "  --candidates <K>       Expand only the K best candidates of every beam node, ranked by static\n"
+              << "                         bound and colour refinement. Defaults to all free vertices.\n"
+              << "  --threads <N>          Size of the thread pool shared by all algorithms (default 1). With N > 1\n"
+              << "                         every level of the approximate beam is expanded in parallel.\n"
+              << "  --multi-start          Run randomised beam searches on all --threads until --time-limit and\n"
+              << "                         keep the best mapping (approximate algorithm only).\n"
+              << "  --refine <ms>          Improve the found mapping by local search for at most <ms>.\n"
+              << "  --batch <in> <out>     Solve every file of directory <in>, or every path listed in file <in>,\n"
+              << "                         writing <out>/<name>.out per input and <out>/summary.tsv, each with the\n"
+              << "                         other options applied. The inputs in progress are time-sliced over\n"
+              << "                         --threads threads, the one that has run the least going first.\n"
+              << "  --build-index <g2> <index>\n"
+              << "                         Write the graph of file <g2> and everything precomputed about it as a\n"
+              << "                         host graph to the binary file <index>.\n"
+              << "  --index <index>        Take G2 and its preprocessing from <index>, the input file then only\n"
+              << "                         needs G1.\n"
+              << "  --serve <sock> <g2>    Keep the graph of file or index <g2> resident as G2 and answer requests\n"
+              << "                         on unix socket <sock>: 'solve <engine> <k> <deadline ms>' followed by\n"
+              << "                         G1, or 'shutdown'. Engines: default, exact, bnb, bruteforce, portfolio,\n"
+              << "                         approx, multi-start, anneal, frontier. Requests are time-sliced over\n"
+              << "                         --threads threads like batch inputs. SIGINT or SIGTERM answers the\n"
+              << "                         requests in flight with their best mapping so far and stops.\n"
+              << "  --serve-timeout <ms>   Time a --serve client has to send its request and to take in the\n"
+              << "                         response (default 30000).\n"
+              << "  --memory-limit <MiB>   Start no further batch input while the resident size is above <MiB>.\n"
+              << "                         With --scratch, the memory of the open list before it spills (default\n"
+              << "                         1024).\n"
+              << "  --scratch <dir>        Precise A* only: keep the open list compact and spill it to files in\n"
+              << "                         <dir> once it outgrows --memory-limit.\n"
+              << "  --cache <dir>          Reuse mappings found earlier for the same graph pair and options, stored\n"
+              << "                         in <dir> and shared between processes.\n"
+              << "  --cache-size <MiB>     Evict the least recently used cache entries above <MiB> (default 256).\n"
+              << "  --progress             Print a progress line to stderr every second.\n"
+              << "\nSignals:\n"
+              << "  SIGUSR1                Print the incumbent cost and proven lower bound to stderr.\n"
+              << "  SIGINT, SIGTERM        Stop the search gracefully and write the best mapping found.\n"
               << "\nArguments:\n"
               << "  input                  Path to the input file with the graphs.\n"
               << "  output                 Path to the output file where the extension of the G2 graph will be saved.\n"
@@ -46,8 +125,24 @@ static void PrintAppState()
         "\n--- Application State ---\n", "Mode:\n", "  - Debug traces:    ", (g_AppState.debug ? "yes" : "no"), "\n",
         "  - Internal tests:    ", (g_AppState.run_internal_tests ? "yes" : "no"), "\n",
         "  - Generate Suite:    ", (g_AppState.generate_suite ? "yes" : "no"), "\n",
-        "  - Algorithm:       ", (g_AppState.run_approx ? "Approximate " : "Precise "), "\n",
+        "  - Algorithm:       ",
+        (g_AppState.run_approx || g_AppState.run_anneal || g_AppState.run_frontier ? "Approximate " : "Precise "),
+        (g_AppState.run_bnb ? "(DFBnB)" : ""), (g_AppState.run_anneal ? "(annealing)" : ""),
+        (g_AppState.run_frontier ? "(frontier)" : ""),
+        (g_AppState.run_portfolio ? "(portfolio)" : ""), "\n",
         "  - K:    ", g_AppState.num_results, "\n",
+        "  - Beam width:    ",
+        (g_AppState.beam_width == kDefaultBeamWidth ? std::string("default")
+         : g_AppState.beam_width == kAutoBeamWidth  ? std::string("auto")
+                                                    : std::to_string(g_AppState.beam_width)),
+        "\n",
+        "  - Candidates:    ",
+        (g_AppState.candidates == kAllCandidates ? std::string("all") : std::to_string(g_AppState.candidates)), "\n",
+        "  - Threads:    ", g_AppState.threads, (g_AppState.multi_start ? " (multi-start)" : ""), "\n",
+        "  - Time limit (ms):    ",
+        (g_AppState.time_limit_ms != 0 ? std::to_string(g_AppState.time_limit_ms) : std::string("none")), "\n",
+        "  - Refine (ms):    ", (g_AppState.refine_ms != 0 ? std::to_string(g_AppState.refine_ms) : std::string("no")),
+        "\n",
 
         (g_AppState.generate_graph ? "Input Source:        Generate Graph" : "Input Source:        File"), "\n",
 
@@ -71,6 +166,741 @@ static void PrintAppState()
     );
 }
 
+static void OnReportSignal_(int)
+{
+    if (g_ActiveSearch != nullptr) {
+        g_ActiveSearch->RequestReport();
+    }
+}
+
+static void OnStopSignal_(const int signal)
+{
+    if (g_ActiveSearch != nullptr) {
+        g_ActiveSearch->Cancel();
+    }
+
+    /* A second signal terminates immediately */
+    std::signal(signal, SIG_DFL);
+}
+
+static void InstallSignalHandlers_(SearchContext &ctx)
+{
+    g_ActiveSearch = &ctx;
+    std::signal(SIGUSR1, OnReportSignal_);
+    std::signal(SIGINT, OnStopSignal_);
+    std::signal(SIGTERM, OnStopSignal_);
+}
+
+static void RemoveSignalHandlers_()
+{
+    std::signal(SIGUSR1, SIG_DFL);
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    g_ActiveSearch = nullptr;
+}
+
+static std::size_t GetResidentMemoryBytes_()
+{
+    std::ifstream statm("/proc/self/statm");
+    std::size_t total_pages{};
+    std::size_t resident_pages{};
+    if (!(statm >> total_pages >> resident_pages)) {
+        return 0;
+    }
+    return resident_pages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+static void PrintProgress_(const SearchProgress &progress)
+{
+    std::cerr << "[progress] " << std::fixed << std::setprecision(1) << progress.elapsed_seconds << "s"
+              << " expanded: " << progress.nodes_expanded << " (" << std::setprecision(0) << progress.nodes_per_second
+              << "/s)" << " open: " << progress.open_size << " best f: " << progress.best_f << " incumbent: "
+              << (progress.incumbent_cost == INT_MAX ? std::string("none") : std::to_string(progress.incumbent_cost))
+              << " rss: " << GetResidentMemoryBytes_() / (1024 * 1024) << " MiB" << std::endl;
+}
+
+/* Runs the engine selected by the options */
+static std::vector<Mapping> Solve_(const AppState &options, const Graph &g1, const Graph &g2, SearchContext &ctx)
+{
+    std::vector<Mapping> mappings = {};
+    if (options.run_portfolio) {
+        mappings = AccuratePortfolio(g1, g2, options.num_results, ctx, options.run_bnb);
+    } else if (options.run_frontier && options.run_anneal) {
+        (void)ApproxFrontier(g1, g2, options.num_results, ctx);
+        mappings = ApproxAnnealing(g1, g2, options.num_results, ctx);
+    } else if (options.run_frontier) {
+        mappings = ApproxFrontier(g1, g2, options.num_results, ctx);
+    } else if (options.run_anneal) {
+        mappings = ApproxAnnealing(g1, g2, options.num_results, ctx);
+    } else if (options.run_approx && options.multi_start) {
+        mappings = ApproxAStarMultiStart(
+            g1, g2, options.num_results, ctx, options.beam_width, options.threads, options.candidates
+        );
+    } else if (options.run_approx && options.threads > 1) {
+        mappings = ApproxAStarParallel(
+            g1, g2, options.num_results, ctx, options.beam_width, options.threads, options.candidates
+        );
+    } else if (options.run_approx) {
+        mappings = Approximate(g1, g2, options.num_results, ctx, options.beam_width, options.candidates);
+    } else if (options.run_bruteforce) {
+        mappings = AccurateBruteForce(g1, g2, options.num_results, ctx);
+    } else if (options.run_bnb) {
+        mappings = AccurateBranchAndBound(g1, g2, options.num_results, ctx);
+    } else if (options.scratch != nullptr) {
+        const std::uint64_t memory_mb = options.memory_limit_mb != 0 ? options.memory_limit_mb
+                                                                     : kDefaultOpenListMemoryMb;
+        mappings = AccurateAStarExternal(g1, g2, options.num_results, ctx, options.scratch, memory_mb * 1024 * 1024);
+    } else {
+        mappings = Accurate(g1, g2, options.num_results, ctx);
+    }
+    return mappings;
+}
+
+/* Solve_ in one slice, for the engines that have no resumable form */
+static SearchTask BlockingSolveTask_(const AppState &options, const Graph &g1, const Graph &g2, SearchContext &ctx)
+{
+    co_return Solve_(options, g1, g2, ctx);
+}
+
+/* Solve_ as a task for SearchScheduler. The A* and the single-threaded beam yield every kDefaultSearchSlice
+ * expansions, every other engine runs in a single slice. The arguments must outlive the task. */
+static SearchTask SolveTask_(const AppState &options, const Graph &g1, const Graph &g2, SearchContext &ctx)
+{
+    if (options.run_portfolio || options.run_frontier || options.run_anneal) {
+        return BlockingSolveTask_(options, g1, g2, ctx);
+    }
+    if (options.run_approx) {
+        return options.multi_start || options.threads > 1
+                   ? BlockingSolveTask_(options, g1, g2, ctx)
+                   : ApproxAStarTask(g1, g2, options.num_results, ctx, options.beam_width, options.candidates);
+    }
+    if (options.run_bruteforce || options.run_bnb || options.scratch != nullptr) {
+        return BlockingSolveTask_(options, g1, g2, ctx);
+    }
+    return AccurateAStarTask(g1, g2, options.num_results, ctx);
+}
+
+/* Everything the result of a solve depends on besides the graphs */
+static std::string DescribeEngine_(const AppState &options)
+{
+    std::ostringstream engine;
+    engine << "approx=" << options.run_approx << " bruteforce=" << options.run_bruteforce << " bnb=" << options.run_bnb
+           << " anneal=" << options.run_anneal << " frontier=" << options.run_frontier
+           << " multi_start=" << options.multi_start << " portfolio=" << options.run_portfolio
+           << " k=" << options.num_results << " beam=" << options.beam_width << " candidates=" << options.candidates
+           << " external=" << (options.scratch != nullptr) << " threads=" << options.threads
+           << " time_limit=" << options.time_limit_ms << " refine=" << options.refine_ms;
+    return engine.str();
+}
+
+/* Cache of --cache shared by every solve of the process, null without it */
+static ResultCache *GetResultCache_()
+{
+    static const std::unique_ptr<ResultCache> cache =
+        g_AppState.cache == nullptr
+            ? nullptr
+            : std::make_unique<ResultCache>(
+                  g_AppState.cache,
+                  (g_AppState.cache_size_mb != 0 ? g_AppState.cache_size_mb : kDefaultCacheSizeMb) * 1024 * 1024
+              );
+    return cache.get();
+}
+
+/* HashGraph of G2 when --cache is on, 0 otherwise */
+static std::uint64_t HashHostForCache_(const Graph &g2) { return GetResultCache_() != nullptr ? HashGraph(g2) : 0; }
+
+/* SolveTask_ followed by --refine when the mapping is complete, for the modes that print no per-solve report and run
+ * their solves under SearchScheduler. Goes through --cache, g2_hash being the HashHostForCache_ of G2. The result
+ * is a single mapping, empty when nothing was found. used collects the time spent in the slices of the task. */
+static SearchTask SolveQuietlyTask_(
+    const AppState &options, const Graph &g1, const Graph &g2, const std::uint64_t g2_hash, SearchContext &ctx,
+    std::chrono::nanoseconds &used
+)
+{
+    auto slice_start      = std::chrono::steady_clock::now();
+    ResultCache *cache    = GetResultCache_();
+    const std::string key = cache != nullptr ? cache->MakeKey(g1, g2_hash, DescribeEngine_(options)) : "";
+    if (cache != nullptr) {
+        if (std::optional<Mapping> cached = cache->Lookup(key, g1, g2); cached.has_value()) {
+            used += std::chrono::steady_clock::now() - slice_start;
+            co_return std::vector<Mapping>{*cached};
+        }
+    }
+
+    SearchTask search = SolveTask_(options, g1, g2, ctx);
+    while (!search.Resume()) {
+        used += std::chrono::steady_clock::now() - slice_start;
+        co_yield SearchYield{};
+        slice_start = std::chrono::steady_clock::now();
+    }
+    const std::vector<Mapping> mappings = search.TakeResult();
+    Mapping mapping = mappings.empty() ? Mapping(g1.GetVertices(), g2.GetVertices()) : mappings[0];
+
+    if (options.refine_ms != 0 && mapping.get_mapped_count() == g1.GetVertices()) {
+        SearchContext refine_ctx(std::chrono::milliseconds(options.refine_ms));
+        (void)RefineMapping(g1, g2, mapping, refine_ctx);
+    }
+    if (cache != nullptr && !ctx.IsCancelled()) {
+        cache->Store(key, g1, g2, mapping);
+    }
+    used += std::chrono::steady_clock::now() - slice_start;
+    co_return std::vector<Mapping>{mapping};
+}
+
+/* G1 is the first graph of the input file, G2 and its preprocessing come from the --index file */
+static std::pair<Graph, Graph> ReadWithIndex_(std::shared_ptr<const HostPreprocessing> &preprocessing)
+{
+    std::ifstream input(g_AppState.file);
+    if (!input.is_open()) {
+        throw std::runtime_error("Could not open file for reading: " + std::string(g_AppState.file));
+    }
+    Graph g1 = ReadGraph(input);
+
+    const HostIndex index(g_AppState.index);
+    preprocessing = index.LoadPreprocessing();
+    return {std::move(g1), index.LoadGraph()};
+}
+
+static void BuildIndex_()
+{
+    std::ifstream stream(g_AppState.build_index_input);
+    if (!stream.is_open()) {
+        throw std::runtime_error("Could not open file for reading: " + std::string(g_AppState.build_index_input));
+    }
+    const Graph g2 = ReadGraph(stream);
+
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    BuildHostIndex(g2, *ComputeHostPreprocessing(g2), g_AppState.build_index_output);
+    const auto t1 = std::chrono::high_resolution_clock::now();
+
+    std::cout << "Indexed G2 with " << g2.GetVertices() << " vertices into " << g_AppState.build_index_output << " in "
+              << std::fixed << std::setprecision(1) << std::chrono::duration<double, std::milli>(t1 - t0).count()
+              << " ms\n";
+}
+
+// ------------------------------
+// Batch mode
+// ------------------------------
+
+/* Written to the output directory of a batch, one line per input */
+static constexpr const char *kBatchSummaryName = "summary.tsv";
+
+/* Batch jobs admitted at once per thread, more than one so that short inputs can overtake long ones */
+static constexpr std::size_t kBatchJobsPerThread = 4;
+
+struct BatchJob_ {
+    std::filesystem::path input;
+    std::filesystem::path output;
+    std::string status{"skipped"};
+    int cost{-1};
+    double time_ms{};
+};
+
+/* Regular files of a directory in name order, or the paths listed one per line in a file ('#' starts a comment) */
+static std::vector<std::filesystem::path> ListBatchInputs_(const std::filesystem::path &source)
+{
+    std::vector<std::filesystem::path> inputs;
+    if (std::filesystem::is_directory(source)) {
+        for (const auto &entry : std::filesystem::directory_iterator(source)) {
+            if (entry.is_regular_file()) {
+                inputs.push_back(entry.path());
+            }
+        }
+        std::sort(inputs.begin(), inputs.end());
+        return inputs;
+    }
+
+    std::ifstream list(source);
+    if (!list) {
+        throw std::runtime_error("Could not open batch list: " + source.string());
+    }
+    for (std::string line; std::getline(list, line);) {
+        line.erase(std::find(line.begin(), line.end(), '#'), line.end());
+        const auto first = line.find_first_not_of(" \t\r");
+        if (first != std::string::npos) {
+            inputs.emplace_back(line.substr(first, line.find_last_not_of(" \t\r") - first + 1));
+        }
+    }
+    return inputs;
+}
+
+/* One input of --batch as a scheduler job, finished is called with the job filled in */
+static SearchTask BatchJobTask_(BatchJob_ &job, const std::function<void(BatchJob_ &)> &finished)
+{
+    try {
+        const auto [g1, g2] = Read(job.input.c_str());
+
+        SearchContext ctx{};
+        if (g_AppState.time_limit_ms != 0) {
+            ctx.SetTimeLimit(std::chrono::milliseconds(g_AppState.time_limit_ms));
+        }
+
+        /* Only the slices of this job count, not the time it waited for the others */
+        std::chrono::nanoseconds used{};
+        SearchTask solve = SolveQuietlyTask_(g_AppState, g1, g2, HashHostForCache_(g2), ctx, used);
+        while (!solve.Resume()) {
+            co_yield SearchYield{};
+        }
+        const Mapping mapping          = solve.TakeResult()[0];
+        const std::uint64_t time_spent = used.count();
+
+        const bool complete = mapping.get_mapped_count() == g1.GetVertices();
+        WriteResult(job.output.c_str(), g1, g2, mapping, time_spent);
+        job.status  = !complete ? "no-mapping" : ctx.IsDeadlineExpired() ? "timeout" : "ok";
+        job.cost    = complete ? CalculateMappingCost(g1, g2, mapping) : -1;
+        job.time_ms = static_cast<double>(time_spent) / 1e6;
+    } catch (const std::exception &e) {
+        job.status = std::string("error: ") + e.what();
+    }
+
+    finished(job);
+    co_return std::vector<Mapping>{};
+}
+
+static void WriteBatchSummary_(const std::filesystem::path &file, const std::vector<BatchJob_> &jobs)
+{
+    std::ofstream summary(file);
+    if (!summary) {
+        throw std::runtime_error("Error: Could not open file for writing: " + file.string());
+    }
+
+    summary << "input\tstatus\tcost\ttime_ms\toutput\n";
+    for (const BatchJob_ &job : jobs) {
+        summary << job.input.string() << '\t' << job.status << '\t' << job.cost << '\t' << std::fixed
+                << std::setprecision(3) << job.time_ms << '\t' << job.output.string() << '\n';
+    }
+}
+
+/* Solves every input of --batch in this process. The admitted jobs share --threads threads of SearchScheduler, which
+ * gives the next slice to the job that has run the least, so a few pathological inputs do not hold up the rest. A
+ * finished job admits the next ones: up to kBatchJobsPerThread per thread at once, and none while the resident size
+ * is over --memory-limit unless nothing else is running. */
+static void RunBatch_()
+{
+    const std::filesystem::path output_dir(g_AppState.batch_output);
+    std::filesystem::create_directories(output_dir);
+
+    std::vector<BatchJob_> jobs;
+    for (const std::filesystem::path &input : ListBatchInputs_(g_AppState.batch)) {
+        BatchJob_ &job = jobs.emplace_back();
+        job.input      = input;
+        job.output     = output_dir / (input.stem().string() + ".out");
+    }
+    std::cout << "Batch of " << jobs.size() << " inputs into " << output_dir.string() << "\n";
+
+    const std::size_t memory_limit = g_AppState.memory_limit_mb * 1024 * 1024;
+    const auto over_memory_limit   = [&] {
+        return memory_limit != 0 && GetResidentMemoryBytes_() > memory_limit;
+    };
+
+    SearchScheduler scheduler(g_AppState.threads);
+    std::mutex mutex;
+    std::size_t admitted = 0;
+    std::size_t running  = 0;
+    std::size_t done     = 0;
+
+    /* Called under the lock */
+    std::function<void(BatchJob_ &)> finished;
+    const auto admit = [&] {
+        const std::size_t window = std::size_t{g_AppState.threads} * kBatchJobsPerThread;
+        while (admitted < jobs.size() && running < window && (running == 0 || !over_memory_limit())) {
+            ++running;
+            scheduler.SubmitDetached(BatchJobTask_(jobs[admitted++], finished));
+        }
+    };
+    finished = [&](BatchJob_ &job) {
+        std::lock_guard lock(mutex);
+        --running;
+        std::cout << "[" << ++done << "/" << jobs.size() << "] " << job.input.string() << ": " << job.status
+                  << ", cost " << job.cost << ", " << std::fixed << std::setprecision(1) << job.time_ms << " ms"
+                  << std::endl;
+        admit();
+    };
+
+    {
+        std::lock_guard lock(mutex);
+        admit();
+    }
+    scheduler.Run();
+
+    WriteBatchSummary_(output_dir / kBatchSummaryName, jobs);
+}
+
+// ------------------------------
+// Serve mode
+// ------------------------------
+
+/* Pending connections the kernel queues for the accept loop */
+static constexpr int kServeBacklog = 64;
+
+/* Interval at which the accept loop checks for a stop request */
+static constexpr int kServePollMs = 200;
+
+/* Time a client has to send its whole request, and to take in the response, unless set by --serve-timeout */
+static constexpr std::uint64_t kServeReceiveTimeoutMs = 30000;
+
+/* Requests over this size are refused */
+static constexpr std::size_t kServeMaxRequestBytes = std::size_t{256} * 1024 * 1024;
+
+static std::atomic<bool> g_StopServing{false};
+
+/* Set by a stop signal, which unlike a shutdown request also cancels the requests in flight */
+static std::atomic<bool> g_CancelServing{false};
+
+/* Contexts of the requests being solved, cancelled by the accept thread once g_CancelServing is set */
+static std::mutex g_ServedRequestsMutex{};
+static std::vector<SearchContext *> g_ServedRequests{};
+
+static void OnServeStopSignal_(const int signal)
+{
+    g_StopServing.store(true, std::memory_order_relaxed);
+    g_CancelServing.store(true, std::memory_order_relaxed);
+
+    /* A second signal terminates immediately */
+    std::signal(signal, SIG_DFL);
+}
+
+static void CancelServedRequests_()
+{
+    std::lock_guard lock(g_ServedRequestsMutex);
+    for (SearchContext *ctx : g_ServedRequests) {
+        ctx->Cancel();
+    }
+}
+
+/* Registers the context of a request for the lifetime of its solve, one that starts after a stop signal is cancelled
+ * right away */
+class ServedRequestScope_
+{
+    public:
+    explicit ServedRequestScope_(SearchContext &ctx) : ctx_(ctx)
+    {
+        std::lock_guard lock(g_ServedRequestsMutex);
+        g_ServedRequests.push_back(&ctx_);
+        if (g_CancelServing.load(std::memory_order_relaxed)) {
+            ctx_.Cancel();
+        }
+    }
+
+    ServedRequestScope_(const ServedRequestScope_ &)            = delete;
+    ServedRequestScope_ &operator=(const ServedRequestScope_ &) = delete;
+
+    ~ServedRequestScope_()
+    {
+        std::lock_guard lock(g_ServedRequestsMutex);
+        g_ServedRequests.erase(std::find(g_ServedRequests.begin(), g_ServedRequests.end(), &ctx_));
+    }
+
+    private:
+    SearchContext &ctx_;
+};
+
+/* Engine of a request, "default" keeps the one given on the command line */
+static void SelectEngine_(AppState &options, const std::string_view engine)
+{
+    if (engine == "default") {
+        return;
+    }
+
+    options.run_approx     = false;
+    options.run_bruteforce = false;
+    options.run_bnb        = false;
+    options.run_anneal     = false;
+    options.run_frontier   = false;
+    options.multi_start    = false;
+    options.run_portfolio  = false;
+
+    if (engine == "exact") {
+    } else if (engine == "bnb") {
+        options.run_bnb = true;
+    } else if (engine == "bruteforce") {
+        options.run_bruteforce = true;
+    } else if (engine == "portfolio") {
+        options.run_portfolio = true;
+    } else if (engine == "approx") {
+        options.run_approx = true;
+    } else if (engine == "multi-start") {
+        options.run_approx  = true;
+        options.multi_start = true;
+    } else if (engine == "anneal") {
+        options.run_anneal = true;
+    } else if (engine == "frontier") {
+        options.run_frontier = true;
+    } else {
+        throw std::runtime_error("Unknown engine " + std::string(engine));
+    }
+}
+
+/* Connection whose request is still arriving */
+struct PendingRequest_ {
+    int fd{};
+    std::string request{};
+    std::chrono::steady_clock::time_point deadline{};
+};
+
+/* Reads what the client has sent so far without blocking. Returns true once the client has half-closed its side,
+ * which ends the request. Throws when the request grows over kServeMaxRequestBytes. */
+static bool ReceiveRequest_(PendingRequest_ &pending)
+{
+    char buffer[4096];
+    while (true) {
+        const ssize_t received = recv(pending.fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (received == 0) {
+            return true;
+        }
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return false;
+            }
+            throw std::runtime_error("Error receiving request: " + std::string(std::strerror(errno)));
+        }
+        if (pending.request.size() + static_cast<std::size_t>(received) > kServeMaxRequestBytes) {
+            throw std::runtime_error("Request larger than " + std::to_string(kServeMaxRequestBytes) + " bytes");
+        }
+        pending.request.append(buffer, static_cast<std::size_t>(received));
+    }
+}
+
+/* The socket has a send timeout, a client that does not read gets a truncated response */
+static void SendResponse_(const int fd, const std::string_view response)
+{
+    std::size_t sent = 0;
+    while (sent < response.size()) {
+        const ssize_t written = send(fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return;
+        }
+        sent += static_cast<std::size_t>(written);
+    }
+}
+
+struct SolveRequest_ {
+    AppState options;
+    Graph g1;
+};
+
+/* The solve request in the text, nullopt for a shutdown request */
+static std::optional<SolveRequest_> ParseRequest_(const std::string &request)
+{
+    std::istringstream stream(request);
+    std::string command;
+    stream >> command;
+    if (command == "shutdown") {
+        return std::nullopt;
+    }
+    if (command != "solve") {
+        throw std::runtime_error("Unknown command " + command);
+    }
+
+    std::string engine;
+    int k{};
+    std::uint64_t deadline_ms{};
+    stream >> engine >> k >> deadline_ms;
+    if (stream.fail() || k < 1) {
+        throw std::runtime_error("Malformed solve header, expected: solve <engine> <k> <deadline ms>");
+    }
+
+    AppState options = g_AppState;
+    SelectEngine_(options, engine);
+    options.num_results   = k;
+    options.time_limit_ms = deadline_ms != 0 ? deadline_ms : options.time_limit_ms;
+    return SolveRequest_{options, ReadGraph(stream)};
+}
+
+/* Request: a "solve <engine> <k> <deadline ms>" line followed by G1 in the input file format, a zero deadline meaning
+ * --time-limit. Response: "ok <cost> <time ms>" and a line with the G2 image of every G1 vertex, or "error <what>".
+ * A "shutdown" request stops the server once the requests in flight are answered, a stop signal cancels them. Runs
+ * as a scheduler job, the time reported is that of its own slices, and closes the connection at the end. */
+static SearchTask AnswerRequestTask_(
+    const int fd, const std::string request, const Graph &g2, const std::uint64_t g2_hash
+)
+{
+    std::string response = "ok\n";
+    try {
+        const std::optional<SolveRequest_> solve_request = ParseRequest_(request);
+        if (solve_request.has_value()) {
+            const AppState &options = solve_request->options;
+            const Graph &g1         = solve_request->g1;
+
+            SearchContext ctx{};
+            if (options.time_limit_ms != 0) {
+                ctx.SetTimeLimit(std::chrono::milliseconds(options.time_limit_ms));
+            }
+            const ServedRequestScope_ served(ctx);
+
+            std::chrono::nanoseconds used{};
+            SearchTask solve = SolveQuietlyTask_(options, g1, g2, g2_hash, ctx, used);
+            while (!solve.Resume()) {
+                co_yield SearchYield{};
+            }
+            const Mapping mapping = solve.TakeResult()[0];
+            if (mapping.get_mapped_count() != g1.GetVertices()) {
+                throw std::runtime_error("No mapping found");
+            }
+
+            std::ostringstream stream;
+            stream << "ok " << CalculateMappingCost(g1, g2, mapping) << " " << std::fixed << std::setprecision(3)
+                   << std::chrono::duration<double, std::milli>(used).count() << "\n";
+            for (Vertex v1 = 0; v1 < g1.GetVertices(); ++v1) {
+                stream << mapping.get_mapping_g1_to_g2(v1) << (v1 + 1 == g1.GetVertices() ? "\n" : " ");
+            }
+            response = stream.str();
+        } else {
+            g_StopServing.store(true, std::memory_order_relaxed);
+        }
+    } catch (const std::exception &e) {
+        response = std::string("error ") + e.what() + "\n";
+    }
+
+    SendResponse_(fd, response);
+    close(fd);
+    co_return std::vector<Mapping>{};
+}
+
+/* G2 from an index written by --build-index, or from a text file holding that graph alone */
+static Graph ReadHost_(const char *file, std::shared_ptr<const HostPreprocessing> &preprocessing)
+{
+    if (HostIndex::IsIndexFile(file)) {
+        const HostIndex index(file);
+        preprocessing = index.LoadPreprocessing();
+        return index.LoadGraph();
+    }
+
+    std::ifstream stream(file);
+    if (!stream.is_open()) {
+        throw std::runtime_error("Could not open file for reading: " + std::string(file));
+    }
+    Graph g2      = ReadGraph(stream);
+    preprocessing = ComputeHostPreprocessing(g2);
+    return g2;
+}
+
+/* Answers an unfinished request with an error and closes its connection */
+static void RejectRequest_(const PendingRequest_ &pending, const std::string &error)
+{
+    SendResponse_(pending.fd, "error " + error + "\n");
+    close(pending.fd);
+}
+
+/* Keeps G2 of --serve resident together with its preprocessing and answers solve requests on a unix socket. This
+ * thread accepts connections and reads requests without blocking, a complete request becomes a job of a
+ * SearchScheduler on --threads threads. */
+static void Serve_()
+{
+    std::shared_ptr<const HostPreprocessing> preprocessing{};
+    const Graph g2 = ReadHost_(g_AppState.serve_host, preprocessing);
+    const ResidentHostScope resident(g2, preprocessing);
+    const std::uint64_t g2_hash = HashHostForCache_(g2);
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (std::strlen(g_AppState.serve_socket) >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path too long: " + std::string(g_AppState.serve_socket));
+    }
+    std::strcpy(address.sun_path, g_AppState.serve_socket);
+
+    const int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        throw std::runtime_error("Error creating socket: " + std::string(std::strerror(errno)));
+    }
+    unlink(g_AppState.serve_socket);
+    if (bind(listener, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 ||
+        listen(listener, kServeBacklog) != 0) {
+        const std::string error = std::strerror(errno);
+        close(listener);
+        throw std::runtime_error("Error listening on " + std::string(g_AppState.serve_socket) + ": " + error);
+    }
+
+    g_StopServing.store(false, std::memory_order_relaxed);
+    g_CancelServing.store(false, std::memory_order_relaxed);
+    std::signal(SIGINT, OnServeStopSignal_);
+    std::signal(SIGTERM, OnServeStopSignal_);
+    std::cout << "Serving G2 with " << g2.GetVertices() << " vertices on " << g_AppState.serve_socket << std::endl;
+
+    SearchScheduler scheduler(g_AppState.threads);
+    scheduler.Hold();
+    std::atomic<bool> drained{false};
+    std::thread runner([&scheduler, &drained] {
+        scheduler.Run();
+        drained.store(true, std::memory_order_release);
+    });
+
+    const std::uint64_t timeout_ms  = g_AppState.serve_timeout_ms != 0 ? g_AppState.serve_timeout_ms
+                                                                       : kServeReceiveTimeoutMs;
+    const auto timeout              = std::chrono::milliseconds(timeout_ms);
+    const std::string timeout_error = "Request not received within " + std::to_string(timeout_ms) + " ms";
+    const timeval send_timeout{
+        static_cast<time_t>(timeout_ms / 1000), static_cast<suseconds_t>(timeout_ms % 1000 * 1000)
+    };
+    std::vector<PendingRequest_> pending;
+    std::vector<pollfd> waiting;
+    while (!g_StopServing.load(std::memory_order_relaxed)) {
+        waiting.assign(1, pollfd{listener, POLLIN, 0});
+        for (const PendingRequest_ &request : pending) {
+            waiting.push_back(pollfd{request.fd, POLLIN, 0});
+        }
+        if (poll(waiting.data(), waiting.size(), kServePollMs) < 0) {
+            continue;
+        }
+
+        const auto now   = std::chrono::steady_clock::now();
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < pending.size(); ++i) {
+            PendingRequest_ &request = pending[i];
+            try {
+                if (waiting[i + 1].revents != 0 && ReceiveRequest_(request)) {
+                    scheduler.SubmitDetached(AnswerRequestTask_(request.fd, std::move(request.request), g2, g2_hash));
+                    continue;
+                }
+            } catch (const std::exception &e) {
+                RejectRequest_(request, e.what());
+                continue;
+            }
+            if (now >= request.deadline) {
+                RejectRequest_(request, timeout_error);
+                continue;
+            }
+            if (kept != i) {
+                pending[kept] = std::move(request);
+            }
+            ++kept;
+        }
+        pending.resize(kept);
+
+        if ((waiting[0].revents & POLLIN) != 0) {
+            const int client = accept(listener, nullptr, nullptr);
+            if (client >= 0) {
+                setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &send_timeout, sizeof(send_timeout));
+                pending.push_back(PendingRequest_{client, {}, now + timeout});
+            }
+        }
+    }
+
+    for (const PendingRequest_ &request : pending) {
+        RejectRequest_(request, "Server shutting down");
+    }
+    scheduler.Release();
+
+    /* A stop signal, also one arriving while a shutdown request drains, cuts the requests in flight short */
+    while (!drained.load(std::memory_order_acquire)) {
+        if (g_CancelServing.load(std::memory_order_relaxed)) {
+            CancelServedRequests_();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(kServePollMs));
+    }
+    runner.join();
+
+    close(listener);
+    unlink(g_AppState.serve_socket);
+    RemoveSignalHandlers_();
+}
+
 // ------------------------------
 // Imlemenatations
 // ------------------------------
@@ -95,12 +925,171 @@ void ParseArgs(int argc, const char *const argv[])
             g_AppState.run_approx = true;
         } else if (arg == "--bruteforce") {
             g_AppState.run_bruteforce = true;
+        } else if (arg == "--bnb") {
+            g_AppState.run_bnb = true;
+        } else if (arg == "--portfolio") {
+            g_AppState.run_portfolio = true;
+        } else if (arg == "--anneal") {
+            g_AppState.run_anneal = true;
+        } else if (arg == "--frontier") {
+            g_AppState.run_frontier = true;
+        } else if (arg == "--multi-start") {
+            g_AppState.multi_start = true;
         } else if (arg == "--debug") {
             g_AppState.debug = true;
         } else if (arg == "--run_internal_tests") {
             g_AppState.run_internal_tests = true;
         } else if (arg == "--gen-suite") {
             g_AppState.generate_suite = true;
+        } else if (arg == "--progress") {
+            g_AppState.progress = true;
+        } else if (arg == "--time-limit") {
+            if (i + 1 >= args.size()) {
+                throw std::runtime_error("--time-limit requires a value in milliseconds.");
+            }
+            try {
+                g_AppState.time_limit_ms = std::stoull(std::string(args[i + 1]));
+            } catch (const std::exception &e) {
+                throw std::runtime_error("Error parsing --time-limit argument: " + std::string(e.what()));
+            }
+            if (g_AppState.time_limit_ms == 0) {
+                throw std::runtime_error("--time-limit must be positive.");
+            }
+            ++i;
+        } else if (arg == "--beam") {
+            if (i + 1 >= args.size()) {
+                throw std::runtime_error("--beam requires a width or 'auto'.");
+            }
+            if (args[i + 1] == "auto") {
+                g_AppState.beam_width = kAutoBeamWidth;
+            } else {
+                try {
+                    g_AppState.beam_width = static_cast<std::uint32_t>(std::stoul(std::string(args[i + 1])));
+                } catch (const std::exception &e) {
+                    throw std::runtime_error("Error parsing --beam argument: " + std::string(e.what()));
+                }
+                if (g_AppState.beam_width == kDefaultBeamWidth || g_AppState.beam_width == kAutoBeamWidth) {
+                    throw std::runtime_error("--beam width must be positive.");
+                }
+            }
+            ++i;
+        } else if (arg == "--refine") {
+            if (i + 1 >= args.size()) {
+                throw std::runtime_error("--refine requires a value in milliseconds.");
+            }
+            try {
+                g_AppState.refine_ms = std::stoull(std::string(args[i + 1]));
+            } catch (const std::exception &e) {
+                throw std::runtime_error("Error parsing --refine argument: " + std::string(e.what()));
+            }
+            if (g_AppState.refine_ms == 0) {
+                throw std::runtime_error("--refine must be positive.");
+            }
+            ++i;
+        } else if (arg == "--threads") {
+            if (i + 1 >= args.size()) {
+                throw std::runtime_error("--threads requires a value.");
+            }
+            try {
+                g_AppState.threads = static_cast<unsigned>(std::stoul(std::string(args[i + 1])));
+            } catch (const std::exception &e) {
+                throw std::runtime_error("Error parsing --threads argument: " + std::string(e.what()));
+            }
+            if (g_AppState.threads == 0) {
+                throw std::runtime_error("--threads must be positive.");
+            }
+            ++i;
+        } else if (arg == "--candidates") {
+            if (i + 1 >= args.size()) {
+                throw std::runtime_error("--candidates requires a value.");
+            }
+            try {
+                g_AppState.candidates = static_cast<std::uint32_t>(std::stoul(std::string(args[i + 1])));
+            } catch (const std::exception &e) {
+                throw std::runtime_error("Error parsing --candidates argument: " + std::string(e.what()));
+            }
+            if (g_AppState.candidates == 0) {
+                throw std::runtime_error("--candidates must be positive.");
+            }
+            ++i;
+        } else if (arg == "--batch") {
+            if (i + 2 >= args.size()) {
+                throw std::runtime_error("--batch requires an input directory or list and an output directory.");
+            }
+            g_AppState.batch        = argv[i + 2];
+            g_AppState.batch_output = argv[i + 3];
+            i += 2;
+        } else if (arg == "--build-index") {
+            if (i + 2 >= args.size()) {
+                throw std::runtime_error("--build-index requires a G2 file and an index file.");
+            }
+            g_AppState.build_index_input  = argv[i + 2];
+            g_AppState.build_index_output = argv[i + 3];
+            i += 2;
+        } else if (arg == "--index") {
+            if (i + 1 >= args.size()) {
+                throw std::runtime_error("--index requires an index file.");
+            }
+            g_AppState.index = argv[i + 2];
+            ++i;
+        } else if (arg == "--serve") {
+            if (i + 2 >= args.size()) {
+                throw std::runtime_error("--serve requires a socket path and a G2 file.");
+            }
+            g_AppState.serve_socket = argv[i + 2];
+            g_AppState.serve_host   = argv[i + 3];
+            i += 2;
+        } else if (arg == "--serve-timeout") {
+            if (i + 1 >= args.size()) {
+                throw std::runtime_error("--serve-timeout requires a value in milliseconds.");
+            }
+            try {
+                g_AppState.serve_timeout_ms = std::stoull(std::string(args[i + 1]));
+            } catch (const std::exception &e) {
+                throw std::runtime_error("Error parsing --serve-timeout argument: " + std::string(e.what()));
+            }
+            if (g_AppState.serve_timeout_ms == 0) {
+                throw std::runtime_error("--serve-timeout must be positive.");
+            }
+            ++i;
+        } else if (arg == "--cache") {
+            if (i + 1 >= args.size()) {
+                throw std::runtime_error("--cache requires a directory.");
+            }
+            g_AppState.cache = argv[i + 2];
+            ++i;
+        } else if (arg == "--cache-size") {
+            if (i + 1 >= args.size()) {
+                throw std::runtime_error("--cache-size requires a value in MiB.");
+            }
+            try {
+                g_AppState.cache_size_mb = std::stoull(std::string(args[i + 1]));
+            } catch (const std::exception &e) {
+                throw std::runtime_error("Error parsing --cache-size argument: " + std::string(e.what()));
+            }
+            if (g_AppState.cache_size_mb == 0) {
+                throw std::runtime_error("--cache-size must be positive.");
+            }
+            ++i;
+        } else if (arg == "--scratch") {
+            if (i + 1 >= args.size()) {
+                throw std::runtime_error("--scratch requires a directory.");
+            }
+            g_AppState.scratch = argv[i + 2];
+            ++i;
+        } else if (arg == "--memory-limit") {
+            if (i + 1 >= args.size()) {
+                throw std::runtime_error("--memory-limit requires a value in MiB.");
+            }
+            try {
+                g_AppState.memory_limit_mb = std::stoull(std::string(args[i + 1]));
+            } catch (const std::exception &e) {
+                throw std::runtime_error("Error parsing --memory-limit argument: " + std::string(e.what()));
+            }
+            if (g_AppState.memory_limit_mb == 0) {
+                throw std::runtime_error("--memory-limit must be positive.");
+            }
+            ++i;
         } else if (arg == "--gen") {
             if (i + 5 >= args.size()) {
                 throw std::runtime_error("--gen requires 5 arguments.");
@@ -135,12 +1124,14 @@ void ParseArgs(int argc, const char *const argv[])
         }
     }
 
-    const bool is_special_mode =
-        g_AppState.run_internal_tests || g_AppState.generate_graph || g_AppState.generate_suite;
+    const bool is_special_mode = g_AppState.run_internal_tests || g_AppState.generate_graph ||
+                                 g_AppState.generate_suite || g_AppState.batch != nullptr ||
+                                 g_AppState.serve_socket != nullptr || g_AppState.build_index_input != nullptr;
 
     if (!is_special_mode && g_AppState.file == nullptr) {
         throw std::runtime_error(
-            "A filename is required if not running in a special mode (--gen-suite, --run_internal_tests, --gen)."
+            "A filename is required if not running in a special mode (--gen-suite, --run_internal_tests, --gen, "
+            "--batch, --serve, --build-index)."
         );
     }
 
@@ -154,6 +1145,7 @@ void ParseArgs(int argc, const char *const argv[])
 void Run()
 {
     PrintAppState();
+    SetSharedThreadPoolSize(g_AppState.threads);
 
     if (g_AppState.run_internal_tests) {
         TRACE("Running internal tests...");
@@ -183,21 +1175,84 @@ void Run()
         return;
     }
 
+    if (g_AppState.build_index_input != nullptr) {
+        TRACE("Building index...");
+        BuildIndex_();
+        return;
+    }
+
+    if (g_AppState.serve_socket != nullptr) {
+        TRACE("Serving...");
+        Serve_();
+        return;
+    }
+
+    if (g_AppState.batch != nullptr) {
+        TRACE("Running batch...");
+        RunBatch_();
+        return;
+    }
+
     TRACE("Running base application flow...");
-    auto [g1, g2] = Read(g_AppState.file);
+    std::shared_ptr<const HostPreprocessing> preprocessing{};
+    auto [g1, g2] = g_AppState.index != nullptr ? ReadWithIndex_(preprocessing) : Read(g_AppState.file);
+
+    std::optional<ResidentHostScope> resident{};
+    if (preprocessing != nullptr) {
+        resident.emplace(g2, preprocessing);
+    }
     TRACE("Got g1 with size: ", g1.GetVertices(), " and g2 with size: ", g2.GetVertices());
 
-    const auto t0                 = std::chrono::high_resolution_clock::now();
-    std::vector<Mapping> mappings = {};
-    if (g_AppState.run_approx) {
-        mappings = Approximate(g1, g2, g_AppState.num_results);
-    } else if (g_AppState.run_bruteforce) {
-        mappings = AccurateBruteForce(g1, g2, g_AppState.num_results);
+    SearchContext ctx{};
+    if (g_AppState.time_limit_ms != 0) {
+        ctx.SetTimeLimit(std::chrono::milliseconds(g_AppState.time_limit_ms));
+    }
+    if (g_AppState.progress) {
+        ctx.SetProgressCallback(PrintProgress_, std::chrono::milliseconds(1000));
+    }
+    InstallSignalHandlers_(ctx);
+
+    const auto t0               = std::chrono::high_resolution_clock::now();
+    ResultCache *cache          = GetResultCache_();
+    const std::string cache_key =
+        cache != nullptr ? cache->MakeKey(g1, HashHostForCache_(g2), DescribeEngine_(g_AppState)) : "";
+    const std::optional<Mapping> cached =
+        cache != nullptr ? cache->Lookup(cache_key, g1, g2) : std::optional<Mapping>{};
+
+    std::vector<Mapping> mappings{};
+    if (cached.has_value()) {
+        std::cout << "Cache hit, search skipped.\n";
+        mappings.push_back(*cached);
     } else {
-        mappings = Accurate(g1, g2, g_AppState.num_results);
+        mappings = Solve_(g_AppState, g1, g2, ctx);
     }
+
+    const bool refine = g_AppState.refine_ms != 0 && !cached.has_value() && !mappings.empty() && !ctx.IsCancelled() &&
+                        mappings[0].get_mapped_count() == g1.GetVertices();
+    if (refine) {
+        SearchContext refine_ctx(std::chrono::milliseconds(g_AppState.refine_ms));
+        InstallSignalHandlers_(refine_ctx);
+
+        const RefineResult result = RefineMapping(g1, g2, mappings[0], refine_ctx);
+        ctx.OfferIncumbent(mappings[0], result.final_cost);
+        std::cout << "Refined cost: " << result.initial_cost << " -> " << result.final_cost << " ("
+                  << result.moves_applied << " moves)\n";
+    }
+
     const auto t1                  = std::chrono::high_resolution_clock::now();
     const std::uint64_t time_spent = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    RemoveSignalHandlers_();
+
+    if (cache != nullptr && !cached.has_value() && !mappings.empty() && !ctx.IsCancelled()) {
+        cache->Store(cache_key, g1, g2, mappings[0]);
+    }
+
+    if (ctx.IsCancelled()) {
+        std::cout << "Search interrupted, writing the best mapping found.\n";
+    }
+    if (ctx.HasDeadline() || ctx.IsCancelled()) {
+        ctx.Report(std::cout);
+    }
 
     Write(g1, g2, mappings, time_spent);
     if (!mappings.empty()) {
@@ -3,6 +3,8 @@
 
 #include "random_gen.hpp"
 
+#include <cstdint>
+
 void ParseArgs(int argc, const char *const argv[]);
 void Run();
 void OnFail();
@@ -11,13 +13,36 @@ bool IsDebug();
 struct AppState {
     const char *file{};
     const char *output{};
+    const char *batch{};        /* Input directory or list file of --batch */
+    const char *batch_output{}; /* Output directory of --batch */
+    const char *serve_socket{}; /* Unix socket of --serve */
+    const char *serve_host{};   /* File with the resident G2 of --serve */
+    const char *build_index_input{};
+    const char *build_index_output{};
+    const char *index{};
+    const char *cache{};
+    const char *scratch{};
     bool run_approx{};
     bool run_bruteforce{};
+    bool run_bnb{};
+    bool run_anneal{};
+    bool run_frontier{};
+    bool multi_start{};
+    bool run_portfolio{};
     bool debug{};
     bool generate_graph{};
     bool generate_suite{};
     bool run_internal_tests{};
     int num_results{1};
+    std::uint64_t time_limit_ms{};
+    std::uint64_t refine_ms{};
+    std::uint32_t beam_width{}; /* kDefaultBeamWidth or kAutoBeamWidth unless set explicitly */
+    unsigned threads{1};
+    std::uint64_t memory_limit_mb{};
+    std::uint64_t cache_size_mb{}; /* kDefaultCacheSizeMb unless set */
+    std::uint64_t serve_timeout_ms{}; /* kServeReceiveTimeoutMs unless set */
+    std::uint32_t candidates{}; /* kAllCandidates unless set */
+    bool progress{};
     GraphSpec spec{};
 };
 
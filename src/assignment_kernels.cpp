@@ -0,0 +1,156 @@
+#include "assignment_kernels.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <climits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// ------------------------------
+// Helpers
+// ------------------------------
+
+static constexpr Vertices kWordBits = 64;
+
+static FUNC_INLINE int Deficit_(const Edges needed, const Edges found)
+{
+    return needed > found ? static_cast<int>(needed - found) : 0;
+}
+
+static FUNC_INLINE int Blend_(const int cost, const int bound) { return cost + std::max(0, bound - cost) / 2; }
+
+#if defined(__AVX2__)
+
+static constexpr Vertices kLanes = 8;
+
+/* Unsigned max(0, needed - found) in every lane, there is no saturating 32-bit subtraction */
+static FUNC_INLINE __m256i Deficit8_(const __m256i needed, const Edges *found)
+{
+    const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(found));
+    return _mm256_sub_epi32(_mm256_max_epu32(needed, values), values);
+}
+
+/* Lane i is all ones when bit i of the byte is set */
+static FUNC_INLINE __m256i ExpandByte_(const std::uint64_t byte)
+{
+    const __m256i select = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    const __m256i spread = _mm256_and_si256(_mm256_set1_epi32(static_cast<int>(byte)), select);
+    return _mm256_cmpeq_epi32(spread, select);
+}
+
+#endif
+
+// ------------------------------
+// Implementations
+// ------------------------------
+
+void AddEdgeDeficits(
+    int *costs, const Edges *found_out, const Edges needed_out, const Edges *found_in, const Edges needed_in,
+    const Vertices size
+)
+{
+    Vertex u = 0;
+#if defined(__AVX2__)
+    const __m256i out = _mm256_set1_epi32(static_cast<int>(needed_out));
+    const __m256i in  = _mm256_set1_epi32(static_cast<int>(needed_in));
+    for (; u + kLanes <= size; u += kLanes) {
+        __m256i sum = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(costs + u));
+        if (needed_out != 0) {
+            sum = _mm256_add_epi32(sum, Deficit8_(out, found_out + u));
+        }
+        if (needed_in != 0) {
+            sum = _mm256_add_epi32(sum, Deficit8_(in, found_in + u));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(costs + u), sum);
+    }
+#endif
+    for (; u < size; ++u) {
+        costs[u] += (needed_out != 0 ? Deficit_(needed_out, found_out[u]) : 0) +
+                    (needed_in != 0 ? Deficit_(needed_in, found_in[u]) : 0);
+    }
+}
+
+void PruneOverBudget(std::uint64_t *bits, const int *costs, const int *bounds, const int budget, const Vertices size)
+{
+    const Vertices words = (size + kWordBits - 1) / kWordBits;
+    for (Vertices word = 0; word < words; ++word) {
+        if (bits[word] == 0) {
+            continue;
+        }
+
+        const Vertex base  = word * kWordBits;
+        std::uint64_t keep = 0;
+        Vertex offset      = 0;
+#if defined(__AVX2__)
+        const __m256i limit = _mm256_set1_epi32(budget);
+        for (; offset + kLanes <= kWordBits && base + offset + kLanes <= size; offset += kLanes) {
+            const __m256i cost  = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(costs + base + offset));
+            const __m256i bound = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bounds + base + offset));
+            const __m256i fits  = _mm256_cmpgt_epi32(limit, _mm256_max_epi32(cost, bound));
+            keep |= static_cast<std::uint64_t>(_mm256_movemask_ps(_mm256_castsi256_ps(fits))) << offset;
+        }
+#endif
+        for (; offset < kWordBits && base + offset < size; ++offset) {
+            if (std::max(costs[base + offset], bounds[base + offset]) < budget) {
+                keep |= std::uint64_t{1} << offset;
+            }
+        }
+        bits[word] &= keep;
+    }
+}
+
+int MinBlendedCost(const std::uint64_t *bits, const int *costs, const int *bounds, const Vertices size)
+{
+    int best             = INT_MAX;
+    const Vertices words = (size + kWordBits - 1) / kWordBits;
+    for (Vertices word = 0; word < words; ++word) {
+        std::uint64_t remaining = bits[word];
+        const Vertex base       = word * kWordBits;
+#if defined(__AVX2__)
+        /* Whole bytes of the word go through the vector path, the tail past the last full byte below */
+        __m256i minimum = _mm256_set1_epi32(INT_MAX);
+        for (Vertex offset = 0; remaining != 0 && offset + kLanes <= kWordBits && base + offset + kLanes <= size;
+             offset += kLanes) {
+            const std::uint64_t byte = (remaining >> offset) & 0xFF;
+            if (byte == 0) {
+                continue;
+            }
+            const __m256i cost  = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(costs + base + offset));
+            const __m256i bound = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bounds + base + offset));
+            const __m256i slack = _mm256_max_epi32(_mm256_sub_epi32(bound, cost), _mm256_setzero_si256());
+            const __m256i value = _mm256_add_epi32(cost, _mm256_srli_epi32(slack, 1));
+            const __m256i taken = _mm256_blendv_epi8(_mm256_set1_epi32(INT_MAX), value, ExpandByte_(byte));
+            minimum             = _mm256_min_epi32(minimum, taken);
+            remaining &= ~(std::uint64_t{0xFF} << offset);
+        }
+
+        /* Horizontal minimum of the eight lanes */
+        __m128i half = _mm_min_epi32(_mm256_castsi256_si128(minimum), _mm256_extracti128_si256(minimum, 1));
+        half         = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+        half         = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+        best         = std::min(best, _mm_cvtsi128_si32(half));
+#endif
+        while (remaining != 0) {
+            const Vertex u = base + static_cast<Vertex>(std::countr_zero(remaining));
+            best           = std::min(best, Blend_(costs[u], bounds[u]));
+            remaining &= remaining - 1;
+        }
+    }
+    return best;
+}
+
+void GatherColumn(const Graph &g, const Vertex v, Edges *column)
+{
+    for (Vertex u = 0; u < g.GetVertices(); ++u) {
+        column[u] = g.GetEdges(u, v);
+    }
+}
+
+void GatherDiagonal(const Graph &g, Edges *diagonal)
+{
+    for (Vertex u = 0; u < g.GetVertices(); ++u) {
+        diagonal[u] = g.GetEdges(u, u);
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef ASSIGNMENT_KERNELS_HPP
+#define ASSIGNMENT_KERNELS_HPP
+
+#include "graph.hpp"
+
+#include <cstdint>
+
+/* Scoring of one G1 vertex against all G2 candidates at once. Rows are dense arrays indexed by the G2 vertex and
+ * candidate sets are bitsets of 64-bit words, as in CandidateDomains. Built with AVX2 when the compiler targets it
+ * (e.g. -march=native in release builds), with a scalar fallback otherwise. */
+
+/* costs[u] += max(0, needed_out - found_out[u]) + max(0, needed_in - found_in[u]) for every u < size. A side whose
+ * needed count is 0 contributes nothing and its array is not read, it may be null. */
+void AddEdgeDeficits(
+    int *costs, const Edges *found_out, Edges needed_out, const Edges *found_in, Edges needed_in, Vertices size
+);
+
+/* Clears bit u wherever max(costs[u], bounds[u]) >= budget */
+void PruneOverBudget(std::uint64_t *bits, const int *costs, const int *bounds, int budget, Vertices size);
+
+/* Minimum of costs[u] + max(0, bounds[u] - costs[u]) / 2 over the set bits, INT_MAX when there are none */
+NODISCARD int MinBlendedCost(const std::uint64_t *bits, const int *costs, const int *bounds, Vertices size);
+
+/* column[u] = g.GetEdges(u, v), making a column of the matrix contiguous */
+void GatherColumn(const Graph &g, Vertex v, Edges *column);
+
+/* diagonal[u] = g.GetEdges(u, u) */
+void GatherDiagonal(const Graph &g, Edges *diagonal);
+
+#endif  // ASSIGNMENT_KERNELS_HPP
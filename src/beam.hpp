@@ -0,0 +1,324 @@
+#ifndef BEAM_HPP
+#define BEAM_HPP
+
+#include "defines.hpp"
+
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <utility>
+#include <vector>
+
+using NodeHandle = std::uint32_t;
+
+// ------------------------------
+// Node Pool
+// ------------------------------
+
+/* Owns the search nodes of the beam, which only passes small handles around. Released slots are recycled together
+ * with their buffers, so that assigning into them does not allocate. References stay valid while the pool grows. */
+template <class NodeT>
+class NodePool
+{
+    public:
+    NODISCARD NodeHandle Acquire()
+    {
+        if (!free_.empty()) {
+            const NodeHandle handle = free_.back();
+            free_.pop_back();
+            return handle;
+        }
+
+        nodes_.emplace_back();
+        return static_cast<NodeHandle>(nodes_.size() - 1);
+    }
+
+    void Release(const NodeHandle handle)
+    {
+        assert(handle < nodes_.size());
+        free_.push_back(handle);
+    }
+
+    NODISCARD FUNC_INLINE NodeT &Get(const NodeHandle handle)
+    {
+        assert(handle < nodes_.size());
+        return nodes_[handle];
+    }
+
+    NODISCARD size_t GetLiveCount() const { return nodes_.size() - free_.size(); }
+
+    private:
+    std::deque<NodeT> nodes_{};
+    std::vector<NodeHandle> free_{};
+};
+
+// ------------------------------
+// Beam Heap
+// ------------------------------
+
+/* Bounded double-ended priority queue of (f, handle) pairs stored as a min-max heap: even levels are ordered towards
+ * the minimum, odd levels towards the maximum. Both ends are reachable in O(1), insertion and removal are O(log R).
+ *
+ * Equal f values keep the insertion order, so that a full beam always drops the latest of the worst entries. */
+class BeamHeap
+{
+    struct Entry {
+        int f;
+        std::uint64_t seq;
+        NodeHandle handle;
+
+        FUNC_INLINE bool operator<(const Entry &other) const
+        {
+            return f != other.f ? f < other.f : seq < other.seq;
+        }
+    };
+
+    public:
+    explicit BeamHeap(const size_t capacity) : capacity_(capacity) { heap_.reserve(capacity); }
+
+    NODISCARD bool IsEmpty() const { return heap_.empty(); }
+
+    NODISCARD bool IsFull() const { return heap_.size() >= capacity_; }
+
+    NODISCARD size_t Size() const { return heap_.size(); }
+
+    NODISCARD size_t GetCapacity() const { return capacity_; }
+
+    NODISCARD int PeekBestF() const
+    {
+        assert(!heap_.empty());
+        return heap_[0].f;
+    }
+
+    NODISCARD std::uint64_t PeekBestOrder() const
+    {
+        assert(!heap_.empty());
+        return heap_[0].seq;
+    }
+
+    NODISCARD int PeekWorstF() const
+    {
+        assert(!heap_.empty());
+        return heap_[MaxIndex_()].f;
+    }
+
+    /* Returns the handle that did not fit into the beam, either the inserted one or the evicted worst entry. The
+     * caller owns the returned node. */
+    NODISCARD std::optional<NodeHandle> Insert(const int f, const NodeHandle handle)
+    {
+        return Insert(f, seq_++, handle);
+    }
+
+    /* Same as above with an explicit tie-breaking order instead of the insertion order. Orders must grow between
+     * consecutive insertions for the rejection of equal f entries to stay consistent. */
+    NODISCARD std::optional<NodeHandle> Insert(const int f, const std::uint64_t order, const NodeHandle handle)
+    {
+        const Entry entry{f, order, handle};
+
+        if (capacity_ == 0) {
+            return handle;
+        }
+
+        std::optional<NodeHandle> dropped{};
+        if (IsFull()) {
+            const size_t worst = MaxIndex_();
+            if (!(entry < heap_[worst])) {
+                return handle;
+            }
+
+            dropped = heap_[worst].handle;
+            RemoveAt_(worst);
+        }
+
+        heap_.push_back(entry);
+        PushUp_(heap_.size() - 1);
+        return dropped;
+    }
+
+    NODISCARD NodeHandle PopBest()
+    {
+        assert(!heap_.empty());
+        const NodeHandle handle = heap_[0].handle;
+        RemoveAt_(0);
+        return handle;
+    }
+
+    NODISCARD NodeHandle PopWorst()
+    {
+        assert(!heap_.empty());
+        const size_t worst      = MaxIndex_();
+        const NodeHandle handle = heap_[worst].handle;
+        RemoveAt_(worst);
+        return handle;
+    }
+
+    private:
+    static FUNC_INLINE bool IsMinLevel_(const size_t idx) { return (std::bit_width(idx + 1) - 1) % 2 == 0; }
+
+    static FUNC_INLINE size_t Parent_(const size_t idx) { return (idx - 1) / 2; }
+
+    NODISCARD size_t MaxIndex_() const
+    {
+        if (heap_.size() <= 2) {
+            return heap_.size() - 1;
+        }
+        return heap_[2] < heap_[1] ? 1 : 2;
+    }
+
+    void RemoveAt_(const size_t idx)
+    {
+        heap_[idx] = heap_.back();
+        heap_.pop_back();
+
+        if (idx < heap_.size()) {
+            TrickleDown_(idx);
+            PushUp_(idx);
+        }
+    }
+
+    void PushUp_(size_t idx)
+    {
+        if (idx == 0) {
+            return;
+        }
+
+        const size_t parent = Parent_(idx);
+        if (IsMinLevel_(idx)) {
+            if (heap_[parent] < heap_[idx]) {
+                std::swap(heap_[idx], heap_[parent]);
+                PushUpLevel_<true>(parent);
+            } else {
+                PushUpLevel_<false>(idx);
+            }
+        } else {
+            if (heap_[idx] < heap_[parent]) {
+                std::swap(heap_[idx], heap_[parent]);
+                PushUpLevel_<false>(parent);
+            } else {
+                PushUpLevel_<true>(idx);
+            }
+        }
+    }
+
+    /* Moves the entry up through the grandparents, i.e. within the levels of the same kind */
+    template <bool kMaxLevel>
+    void PushUpLevel_(size_t idx)
+    {
+        while (idx > 2) {
+            const size_t grandparent = Parent_(Parent_(idx));
+            if (!Before_<kMaxLevel>(heap_[idx], heap_[grandparent])) {
+                break;
+            }
+            std::swap(heap_[idx], heap_[grandparent]);
+            idx = grandparent;
+        }
+    }
+
+    void TrickleDown_(const size_t idx)
+    {
+        if (IsMinLevel_(idx)) {
+            TrickleDownLevel_<false>(idx);
+        } else {
+            TrickleDownLevel_<true>(idx);
+        }
+    }
+
+    template <bool kMaxLevel>
+    void TrickleDownLevel_(size_t idx)
+    {
+        while (2 * idx + 1 < heap_.size()) {
+            /* Most extreme entry among the children and grandchildren */
+            size_t best = 2 * idx + 1;
+            for (const size_t candidate : {2 * idx + 2, 4 * idx + 3, 4 * idx + 4, 4 * idx + 5, 4 * idx + 6}) {
+                if (candidate < heap_.size() && Before_<kMaxLevel>(heap_[candidate], heap_[best])) {
+                    best = candidate;
+                }
+            }
+
+            if (!Before_<kMaxLevel>(heap_[best], heap_[idx])) {
+                return;
+            }
+            std::swap(heap_[best], heap_[idx]);
+
+            /* A child sits on the opposite level and has no further descendants to fix */
+            if (best <= 2 * idx + 2) {
+                return;
+            }
+
+            if (Before_<kMaxLevel>(heap_[Parent_(best)], heap_[best])) {
+                std::swap(heap_[best], heap_[Parent_(best)]);
+            }
+            idx = best;
+        }
+    }
+
+    /* Ordering of the given level kind: ascending on min levels, descending on max levels */
+    template <bool kMaxLevel>
+    static FUNC_INLINE bool Before_(const Entry &a, const Entry &b)
+    {
+        return kMaxLevel ? b < a : a < b;
+    }
+
+    size_t capacity_;
+    std::uint64_t seq_{0};
+    std::vector<Entry> heap_{};
+};
+
+// ------------------------------
+// Bucket Queue
+// ------------------------------
+
+/* Priority queue of handles keyed by small non-negative integers, one stack per key. The lowest key pops first and
+ * the latest push first among equal keys, which favours the deepest nodes when f ties. Push and pop are O(1)
+ * amortised: the cursor only moves back when a key below it is pushed. */
+class BucketQueue
+{
+    public:
+    void Push(const int key, const NodeHandle handle)
+    {
+        assert(key >= 0);
+        const auto bucket = static_cast<size_t>(key);
+        if (bucket >= buckets_.size()) {
+            buckets_.resize(bucket + 1);
+        }
+
+        buckets_[bucket].push_back(handle);
+        if (size_ == 0 || bucket < min_) {
+            min_ = bucket;
+        }
+        ++size_;
+    }
+
+    NODISCARD NodeHandle PopMin()
+    {
+        assert(!IsEmpty());
+        const NodeHandle handle = buckets_[min_].back();
+        buckets_[min_].pop_back();
+
+        if (--size_ != 0) {
+            while (buckets_[min_].empty()) {
+                ++min_;
+            }
+        }
+        return handle;
+    }
+
+    NODISCARD int GetMinKey() const
+    {
+        assert(!IsEmpty());
+        return static_cast<int>(min_);
+    }
+
+    NODISCARD bool IsEmpty() const { return size_ == 0; }
+
+    NODISCARD size_t GetSize() const { return size_; }
+
+    private:
+    std::vector<std::vector<NodeHandle>> buckets_{};
+    size_t min_{0}; /* Lowest non-empty bucket while the queue is not empty */
+    size_t size_{0};
+};
+
+#endif  // BEAM_HPP
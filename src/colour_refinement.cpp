@@ -0,0 +1,137 @@
+#include "colour_refinement.hpp"
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+// ------------------------------
+// Helpers
+// ------------------------------
+
+/* Full description of a vertex in one round, two vertices get the same colour iff their keys are equal */
+using ColourKey = std::vector<std::uint64_t>;
+
+static ColourKey GetSignatureKey_(const MultiplicitySignature &signature)
+{
+    ColourKey key{signature.self_loop, signature.out_edges.size()};
+    key.insert(key.end(), signature.out_edges.begin(), signature.out_edges.end());
+    key.insert(key.end(), signature.in_edges.begin(), signature.in_edges.end());
+    return key;
+}
+
+static ColourKey GetRefinedKey_(const Graph &g, const std::vector<Colour> &colours, const Vertex v)
+{
+    std::vector<std::tuple<Colour, Edges, Edges>> neighbours;
+    for (Vertex u = 0; u < g.GetVertices(); ++u) {
+        const Edges out_edges = g.GetEdges(v, u);
+        const Edges in_edges  = g.GetEdges(u, v);
+        if (u != v && (out_edges != 0 || in_edges != 0)) {
+            neighbours.emplace_back(colours[u], out_edges, in_edges);
+        }
+    }
+    std::sort(neighbours.begin(), neighbours.end());
+
+    ColourKey key{colours[v]};
+    for (const auto &[colour, out_edges, in_edges] : neighbours) {
+        key.push_back(colour);
+        key.push_back((static_cast<std::uint64_t>(out_edges) << 32) | in_edges);
+    }
+    return key;
+}
+
+/* Assigns dense colour ids to the keys of both graphs, shared between them. Returns the number of colours. */
+static std::size_t AssignColours_(
+    const std::vector<ColourKey> &keys_g1, const std::vector<ColourKey> &keys_g2, std::vector<Colour> &colours_g1,
+    std::vector<Colour> &colours_g2
+)
+{
+    std::map<ColourKey, Colour> ids;
+    const auto assign = [&](const std::vector<ColourKey> &keys, std::vector<Colour> &colours) {
+        colours.resize(keys.size());
+        for (size_t v = 0; v < keys.size(); ++v) {
+            colours[v] = ids.try_emplace(keys[v], static_cast<Colour>(ids.size())).first->second;
+        }
+    };
+
+    assign(keys_g1, colours_g1);
+    assign(keys_g2, colours_g2);
+    return ids.size();
+}
+
+// ------------------------------
+// Implementations
+// ------------------------------
+
+ColourRefinement::ColourRefinement(const Graph &g1, const Graph &g2, const std::uint32_t rounds)
+{
+    std::vector<ColourKey> keys_g1;
+    std::vector<ColourKey> keys_g2;
+    for (const MultiplicitySignature &signature : ComputeSignatures(g1)) {
+        keys_g1.push_back(GetSignatureKey_(signature));
+    }
+    for (const MultiplicitySignature &signature : ComputeSignatures(g2)) {
+        keys_g2.push_back(GetSignatureKey_(signature));
+    }
+
+    colours_g1_.emplace_back();
+    colours_g2_.emplace_back();
+    std::size_t classes = AssignColours_(keys_g1, keys_g2, colours_g1_.back(), colours_g2_.back());
+
+    for (std::uint32_t round = 1; round <= rounds; ++round) {
+        for (Vertex v1 = 0; v1 < g1.GetVertices(); ++v1) {
+            keys_g1[v1] = GetRefinedKey_(g1, colours_g1_.back(), v1);
+        }
+        for (Vertex v2 = 0; v2 < g2.GetVertices(); ++v2) {
+            keys_g2[v2] = GetRefinedKey_(g2, colours_g2_.back(), v2);
+        }
+
+        std::vector<Colour> next_g1;
+        std::vector<Colour> next_g2;
+        const std::size_t next_classes = AssignColours_(keys_g1, keys_g2, next_g1, next_g2);
+
+        /* Refinement only ever splits classes, the same count means the partition is stable */
+        if (next_classes == classes) {
+            break;
+        }
+        classes = next_classes;
+        colours_g1_.push_back(std::move(next_g1));
+        colours_g2_.push_back(std::move(next_g2));
+    }
+}
+
+std::uint32_t ColourRefinement::GetAgreementDepth(const Vertex v1, const Vertex v2) const
+{
+    std::uint32_t depth = 0;
+    while (depth < GetRounds() && colours_g1_[depth][v1] == colours_g2_[depth][v2]) {
+        ++depth;
+    }
+    return depth;
+}
+
+CandidateRanking::CandidateRanking(
+    const Graph &g1, const Graph &g2, const PairLowerBounds &bounds, const Vertices length
+)
+    : length_(length == 0 ? g2.GetVertices() : std::min(length, g2.GetVertices())),
+      ranked_(static_cast<std::size_t>(g1.GetVertices()) * length_)
+{
+    const ColourRefinement refinement(g1, g2);
+
+    std::vector<Vertex> order(g2.GetVertices());
+    std::vector<std::uint32_t> depths(g2.GetVertices());
+    for (Vertex v1 = 0; v1 < g1.GetVertices(); ++v1) {
+        for (Vertex v2 = 0; v2 < g2.GetVertices(); ++v2) {
+            order[v2]  = v2;
+            depths[v2] = refinement.GetAgreementDepth(v1, v2);
+        }
+
+        std::partial_sort(order.begin(), order.begin() + length_, order.end(), [&](const Vertex a, const Vertex b) {
+            const int bound_a = bounds.Get(v1, a);
+            const int bound_b = bounds.Get(v1, b);
+            if (bound_a != bound_b) {
+                return bound_a < bound_b;
+            }
+            return depths[a] != depths[b] ? depths[a] > depths[b] : a < b;
+        });
+        std::copy(order.begin(), order.begin() + length_, ranked_.begin() + static_cast<std::size_t>(v1) * length_);
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef COLOUR_REFINEMENT_HPP
+#define COLOUR_REFINEMENT_HPP
+
+#include "graph.hpp"
+#include "pair_bounds.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using Colour = std::uint32_t;
+
+/* Default number of refinement rounds, each one looks one edge further from the vertex */
+static constexpr std::uint32_t kDefaultRefinementRounds = 3;
+
+/* Weisfeiler-Lehman colour refinement run jointly over G1 and G2, so that colours of both graphs are comparable.
+ * Round 0 colours vertices by their multiplicity signature; every next round by the previous colour together with the
+ * multiset of (neighbour colour, out multiplicity, in multiplicity). Colour ids are exact, not hashes. Stops early once
+ * a round no longer splits any colour class. */
+class ColourRefinement
+{
+    public:
+    ColourRefinement(const Graph &g1, const Graph &g2, std::uint32_t rounds = kDefaultRefinementRounds);
+
+    NODISCARD std::uint32_t GetRounds() const { return static_cast<std::uint32_t>(colours_g1_.size()); }
+
+    NODISCARD FUNC_INLINE Colour GetColourG1(const std::uint32_t round, const Vertex v1) const
+    {
+        return colours_g1_[round][v1];
+    }
+
+    NODISCARD FUNC_INLINE Colour GetColourG2(const std::uint32_t round, const Vertex v2) const
+    {
+        return colours_g2_[round][v2];
+    }
+
+    /* Number of leading rounds in which both vertices share a colour: 0 if their signatures already differ */
+    NODISCARD std::uint32_t GetAgreementDepth(Vertex v1, Vertex v2) const;
+
+    private:
+    std::vector<std::vector<Colour>> colours_g1_{};
+    std::vector<std::vector<Colour>> colours_g2_{};
+};
+
+/* For every G1 vertex the G2 vertices ranked by static lower bound, then by colour agreement depth (deeper first),
+ * then by index. Keeps only the best length entries per vertex, all of them by default. */
+class CandidateRanking
+{
+    public:
+    CandidateRanking(const Graph &g1, const Graph &g2, const PairLowerBounds &bounds, Vertices length = 0);
+
+    NODISCARD Vertices GetLength() const { return length_; }
+
+    NODISCARD FUNC_INLINE const Vertex *Begin(const Vertex v1) const
+    {
+        return ranked_.data() + static_cast<std::size_t>(v1) * length_;
+    }
+
+    NODISCARD FUNC_INLINE const Vertex *End(const Vertex v1) const { return Begin(v1) + length_; }
+
+    private:
+    Vertices length_{};
+    std::vector<Vertex> ranked_{};
+};
+
+#endif  // COLOUR_REFINEMENT_HPP
@@ -0,0 +1,105 @@
+#include "domains.hpp"
+#include "assignment_kernels.hpp"
+
+#include <algorithm>
+#include <climits>
+
+// ------------------------------
+// Helpers
+// ------------------------------
+
+/* Column of G2 towards the newly mapped vertex, reused between the calls of a thread */
+static thread_local std::vector<Edges> tls_column_{};
+
+static FUNC_INLINE int Deficit_(const Edges needed, const Edges found)
+{
+    return needed > found ? static_cast<int>(needed - found) : 0;
+}
+
+// ------------------------------
+// Implementations
+// ------------------------------
+
+CandidateDomains::CandidateDomains(const Graph &g1, const Graph &g2)
+    : size_g1_(g1.GetVertices()),
+      size_g2_(g2.GetVertices()),
+      words_((g2.GetVertices() + kWordBits - 1) / kWordBits),
+      bits_(static_cast<std::size_t>(size_g1_) * words_, ~std::uint64_t{0}),
+      partial_costs_(static_cast<std::size_t>(size_g1_) * size_g2_)
+{
+    /* Clear the padding bits past the last G2 vertex */
+    if (const Vertices tail = size_g2_ % kWordBits; tail != 0) {
+        for (Vertex v1 = 0; v1 < size_g1_; ++v1) {
+            bits_[static_cast<std::size_t>(v1) * words_ + words_ - 1] = (std::uint64_t{1} << tail) - 1;
+        }
+    }
+
+    /* Nothing is mapped yet, so only the self-loop contributes */
+    for (Vertex v1 = 0; v1 < size_g1_; ++v1) {
+        const Edges self_loop = g1.GetEdges(v1, v1);
+        for (Vertex v2 = 0; v2 < size_g2_; ++v2) {
+            partial_costs_[static_cast<std::size_t>(v1) * size_g2_ + v2] = Deficit_(self_loop, g2.GetEdges(v2, v2));
+        }
+    }
+}
+
+bool CandidateDomains::Assign(
+    const Graph &g1, const Graph &g2, const PairLowerBounds &bounds, const Mapping &mapping, const Vertex v1,
+    const Vertex v2, const int g, const int threshold
+)
+{
+    assert(mapping.get_mapping_g1_to_g2(v1) == static_cast<MappedVertex>(v2));
+
+    /* Edges u2 -> v2 and v2 -> u2 for every u2, both contiguous, so that a whole row is updated at once */
+    tls_column_.resize(size_g2_);
+    GatherColumn(g2, v2, tls_column_.data());
+    const Edges *edges_to_v2   = tls_column_.data();
+    const Edges *edges_from_v2 = g2.GetRow(v2);
+
+    for (Vertex u1 = 0; u1 < size_g1_; ++u1) {
+        if (mapping.is_g1_mapped(u1)) {
+            continue;
+        }
+
+        Remove_(u1, v2);
+
+        /* Only neighbours of v1 see their partial costs change. Candidates outside of the domain are updated as well,
+         * which is cheaper than skipping them and harmless as they are never read. */
+        int *row              = &partial_costs_[static_cast<std::size_t>(u1) * size_g2_];
+        const Edges edges_out = g1.GetEdges(u1, v1);
+        const Edges edges_in  = g1.GetEdges(v1, u1);
+        if (edges_out != 0 || edges_in != 0) {
+            AddEdgeDeficits(row, edges_to_v2, edges_out, edges_from_v2, edges_in, size_g2_);
+        }
+
+        if (threshold != INT_MAX) {
+            std::uint64_t *domain = &bits_[static_cast<std::size_t>(u1) * words_];
+            PruneOverBudget(domain, row, bounds.GetRow(u1), threshold - g, size_g2_);
+        }
+
+        /* Dead end: the node is going to be pruned, no need to finish the update */
+        if (GetSize(u1) == 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+Vertices CandidateDomains::GetSize(const Vertex v1) const
+{
+    Vertices size            = 0;
+    const std::uint64_t *row = &bits_[static_cast<std::size_t>(v1) * words_];
+    for (Vertices word = 0; word < words_; ++word) {
+        size += static_cast<Vertices>(std::popcount(row[word]));
+    }
+    return size;
+}
+
+int CandidateDomains::GetMinBlendedCost(const PairLowerBounds &bounds, const Vertex v1) const
+{
+    return MinBlendedCost(
+        &bits_[static_cast<std::size_t>(v1) * words_], &partial_costs_[static_cast<std::size_t>(v1) * size_g2_],
+        bounds.GetRow(v1), size_g2_
+    );
+}
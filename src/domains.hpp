@@ -0,0 +1,76 @@
+#ifndef DOMAINS_HPP
+#define DOMAINS_HPP
+
+#include "State.hpp"
+#include "graph.hpp"
+#include "pair_bounds.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+/* Forward-checking state of a search node: for every unmapped G1 vertex a bitset of still viable G2 candidates,
+ * together with the partial assignment cost of each candidate, i.e. the edges that would have to be added between
+ * v1 and the already mapped vertices (self-loop included) if v1 was mapped onto v2.
+ *
+ * A candidate stays viable while g + max(partial cost, LB[v1][v2]) stays below the pruning threshold
+ * (incumbent cost). Rows of mapped vertices are left untouched and must not be queried. */
+class CandidateDomains
+{
+    static constexpr Vertices kWordBits = 64;
+
+    public:
+    CandidateDomains() = default;
+
+    CandidateDomains(const Graph &g1, const Graph &g2);
+
+    /* Applies the assignment v1 -> v2 (already present in mapping) to the domains of all unmapped vertices.
+     * g is the cost of the node after the assignment. Returns false, leaving the domains partially updated, as soon
+     * as some unmapped vertex loses all of its candidates. */
+    bool Assign(
+        const Graph &g1, const Graph &g2, const PairLowerBounds &bounds, const Mapping &mapping, Vertex v1, Vertex v2,
+        int g, int threshold
+    );
+
+    NODISCARD FUNC_INLINE int GetPartialCost(const Vertex v1, const Vertex v2) const
+    {
+        return partial_costs_[static_cast<std::size_t>(v1) * size_g2_ + v2];
+    }
+
+    NODISCARD FUNC_INLINE bool Contains(const Vertex v1, const Vertex v2) const
+    {
+        return (bits_[static_cast<std::size_t>(v1) * words_ + v2 / kWordBits] >> (v2 % kWordBits)) & 1;
+    }
+
+    NODISCARD Vertices GetSize(Vertex v1) const;
+
+    /* Minimum over the domain of v1 of partial + max(0, LB - partial) / 2, INT_MAX when it is empty */
+    NODISCARD int GetMinBlendedCost(const PairLowerBounds &bounds, Vertex v1) const;
+
+    template <class Func>
+    void IterateDomain(Func func, const Vertex v1) const
+    {
+        const std::uint64_t *row = &bits_[static_cast<std::size_t>(v1) * words_];
+        for (Vertices word = 0; word < words_; ++word) {
+            std::uint64_t bits = row[word];
+            while (bits != 0) {
+                func(static_cast<Vertex>(word * kWordBits + std::countr_zero(bits)));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    private:
+    FUNC_INLINE void Remove_(const Vertex v1, const Vertex v2)
+    {
+        bits_[static_cast<std::size_t>(v1) * words_ + v2 / kWordBits] &= ~(std::uint64_t{1} << (v2 % kWordBits));
+    }
+
+    Vertices size_g1_{};
+    Vertices size_g2_{};
+    Vertices words_{};
+    std::vector<std::uint64_t> bits_{};
+    std::vector<int> partial_costs_{};
+};
+
+#endif  // DOMAINS_HPP
@@ -0,0 +1,175 @@
+#include "external_open_list.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+// ------------------------------
+// Helpers
+// ------------------------------
+
+static std::filesystem::path MakePrivateDirectory_(const std::filesystem::path &scratch)
+{
+    static std::atomic<std::uint64_t> sequence{0};
+
+    std::filesystem::create_directories(scratch);
+    const std::filesystem::path directory = scratch / ("open_list." + std::to_string(getpid()) + "." +
+                                                       std::to_string(sequence.fetch_add(1)));
+    std::filesystem::create_directory(directory);
+    return directory;
+}
+
+// ------------------------------
+// Implementations
+// ------------------------------
+
+ExternalOpenList::ExternalOpenList(
+    const std::filesystem::path &scratch, const std::size_t record_size, const std::uint64_t memory_limit
+)
+    : directory_(MakePrivateDirectory_(scratch)), record_size_(record_size), memory_limit_(memory_limit)
+{
+    assert(record_size_ != 0);
+}
+
+ExternalOpenList::~ExternalOpenList()
+{
+    for (auto &[f, bucket] : buckets_) {
+        Unmap_(bucket);
+    }
+    std::error_code error;
+    std::filesystem::remove_all(directory_, error);
+}
+
+void ExternalOpenList::Push(const int f, const std::uint8_t *record)
+{
+    Bucket_ &bucket = buckets_[f];
+    bucket.memory.insert(bucket.memory.end(), record, record + record_size_);
+    ++bucket.count;
+    ++size_;
+
+    memory_used_ += record_size_;
+    if (memory_used_ > memory_limit_) {
+        Spill_();
+    }
+}
+
+void ExternalOpenList::PopMin(std::uint8_t *record)
+{
+    assert(!IsEmpty());
+
+    const auto it   = buckets_.begin();
+    Bucket_ &bucket = it->second;
+    if (!bucket.memory.empty()) {
+        const std::size_t start = bucket.memory.size() - record_size_;
+        std::memcpy(record, bucket.memory.data() + start, record_size_);
+        bucket.memory.resize(start);
+        memory_used_ -= record_size_;
+    } else {
+        ReadFromFile_(it->first, bucket, record);
+    }
+
+    --size_;
+    if (--bucket.count == 0) {
+        assert(bucket.file_bytes == 0 && bucket.window == nullptr);
+        buckets_.erase(it);
+    }
+}
+
+std::filesystem::path ExternalOpenList::GetBucketPath_(const int f) const
+{
+    return directory_ / ("bucket." + std::to_string(f));
+}
+
+void ExternalOpenList::Spill_()
+{
+    for (auto it = buckets_.rbegin(); it != buckets_.rend() && memory_used_ > memory_limit_ / 2; ++it) {
+        Bucket_ &bucket = it->second;
+        if (bucket.memory.empty()) {
+            continue;
+        }
+
+        const std::string path = GetBucketPath_(it->first).string();
+        const int fd           = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0600);
+        if (fd < 0) {
+            throw std::runtime_error("Could not open open list file " + path + ": " + std::strerror(errno));
+        }
+
+        std::size_t written = 0;
+        while (written < bucket.memory.size()) {
+            const ssize_t result = write(fd, bucket.memory.data() + written, bucket.memory.size() - written);
+            if (result < 0 && errno == EINTR) {
+                continue;
+            }
+            if (result <= 0) {
+                const int error = errno;
+                close(fd);
+                throw std::runtime_error("Could not write open list file " + path + ": " + std::strerror(error));
+            }
+            written += static_cast<std::size_t>(result);
+        }
+        close(fd);
+
+        bucket.file_bytes += written;
+        spilled_bytes_ += written;
+        memory_used_ -= written;
+        std::vector<std::uint8_t>().swap(bucket.memory);
+    }
+}
+
+void ExternalOpenList::ReadFromFile_(const int f, Bucket_ &bucket, std::uint8_t *record)
+{
+    assert(bucket.file_read < bucket.file_bytes);
+
+    /* The window ends where the file ended when it was mapped, later spills are picked up by the next one */
+    if (bucket.window == nullptr || bucket.file_read == bucket.window_offset + bucket.window_size) {
+        Unmap_(bucket);
+
+        const std::string path = GetBucketPath_(f).string();
+        const int fd           = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Could not open open list file " + path + ": " + std::strerror(errno));
+        }
+
+        const auto page      = static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+        bucket.window_offset = bucket.file_read / page * page;
+        bucket.window_size   = static_cast<std::size_t>(bucket.file_bytes - bucket.window_offset);
+        void *mapping        = mmap(
+            nullptr, bucket.window_size, PROT_READ, MAP_PRIVATE, fd, static_cast<off_t>(bucket.window_offset)
+        );
+        const int error = errno;
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error("Could not map open list file " + path + ": " + std::strerror(error));
+        }
+        madvise(mapping, bucket.window_size, MADV_SEQUENTIAL);
+        bucket.window = static_cast<std::uint8_t *>(mapping);
+    }
+
+    std::memcpy(record, bucket.window + (bucket.file_read - bucket.window_offset), record_size_);
+    bucket.file_read += record_size_;
+
+    /* Fully read: drop the file, a later spill of this bucket starts a new one */
+    if (bucket.file_read == bucket.file_bytes) {
+        Unmap_(bucket);
+        std::error_code error;
+        std::filesystem::remove(GetBucketPath_(f), error);
+        bucket.file_bytes = 0;
+        bucket.file_read  = 0;
+    }
+}
+
+void ExternalOpenList::Unmap_(Bucket_ &bucket)
+{
+    if (bucket.window != nullptr) {
+        munmap(bucket.window, bucket.window_size);
+        bucket.window      = nullptr;
+        bucket.window_size = 0;
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef EXTERNAL_OPEN_LIST_HPP
+#define EXTERNAL_OPEN_LIST_HPP
+
+#include "defines.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <vector>
+
+/* Default memory of an external open list before it spills to disk */
+static constexpr std::uint64_t kDefaultOpenListMemoryMb = 1024;
+
+/* Open list of fixed-size node records grouped into buckets by f. Once the records in memory exceed the limit, the
+ * buckets with the highest f are appended to files in a private directory under the scratch directory. A bucket
+ * that becomes the minimum pops its records from memory first, newest first, then reads its file sequentially
+ * through a memory mapping. Everything on disk is removed with the list. */
+class ExternalOpenList
+{
+    public:
+    ExternalOpenList(const std::filesystem::path &scratch, std::size_t record_size, std::uint64_t memory_limit);
+
+    ExternalOpenList(const ExternalOpenList &)            = delete;
+    ExternalOpenList &operator=(const ExternalOpenList &) = delete;
+
+    ~ExternalOpenList();
+
+    void Push(int f, const std::uint8_t *record);
+
+    /* Copies a record of the lowest f out and removes it, the list must not be empty */
+    void PopMin(std::uint8_t *record);
+
+    NODISCARD bool IsEmpty() const { return size_ == 0; }
+
+    NODISCARD std::uint64_t GetSize() const { return size_; }
+
+    NODISCARD int GetMinF() const { return buckets_.begin()->first; }
+
+    /* Bytes written to disk over the lifetime of the list */
+    NODISCARD std::uint64_t GetSpilledBytes() const { return spilled_bytes_; }
+
+    private:
+    struct Bucket_ {
+        std::vector<std::uint8_t> memory{};
+        std::uint64_t count{};
+        std::uint64_t file_bytes{}; /* Appended to the file so far */
+        std::uint64_t file_read{};  /* Consumed from the front of the file */
+        std::uint8_t *window{};     /* Mapping of the file from window_offset on */
+        std::size_t window_size{};
+        std::uint64_t window_offset{};
+    };
+
+    NODISCARD std::filesystem::path GetBucketPath_(int f) const;
+
+    /* Appends the highest buckets to their files until the memory is down to half of the limit */
+    void Spill_();
+
+    void ReadFromFile_(int f, Bucket_ &bucket, std::uint8_t *record);
+
+    void Unmap_(Bucket_ &bucket);
+
+    std::filesystem::path directory_;
+    std::size_t record_size_;
+    std::uint64_t memory_limit_;
+    std::uint64_t memory_used_{};
+    std::uint64_t size_{};
+    std::uint64_t spilled_bytes_{};
+    std::map<int, Bucket_> buckets_{};
+};
+
+#endif  // EXTERNAL_OPEN_LIST_HPP
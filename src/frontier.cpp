@@ -0,0 +1,221 @@
+#include "algos.hpp"
+#include "host_index.hpp"
+#include "local_search.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <queue>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// ------------------------------
+// Helpers
+// ------------------------------
+
+/* Resident preprocessing of G2 when registered, otherwise only the parts the greedy reads */
+static std::shared_ptr<const HostPreprocessing> GetHostAdjacency_(const Graph &g2)
+{
+    if (auto host = FindResidentHost(g2); host != nullptr) {
+        return host;
+    }
+
+    SparseAdjacency adjacency(g2);
+    std::vector<std::uint64_t> degrees = ComputeWeightedDegrees(g2, adjacency);
+    return std::make_shared<const HostPreprocessing>(HostPreprocessing{{}, std::move(adjacency), std::move(degrees)});
+}
+
+static FUNC_INLINE Edges Satisfied_(const Edges needed, const Edges found) { return std::min(needed, found); }
+
+// ------------------------------
+// Frontier greedy
+// ------------------------------
+
+/* Greedy construction that maps G1 vertices in order of mapped neighbours. A vertex with mapped neighbours only
+ * considers the free G2 neighbours of their images: any other vertex misses every edge towards them. The candidates
+ * are scored by accumulating the satisfied multiplicities over the G2 adjacency lists, O(sum of G2 degrees) per step.
+ * The first vertex of every G1 component goes onto the highest-degree free G2 vertex instead. */
+class FrontierGreedy_
+{
+    public:
+    FrontierGreedy_(const Graph &g1, const Graph &g2)
+        : g1_(g1),
+          g2_(g2),
+          adjacency_g1_(g1),
+          host_g2_(GetHostAdjacency_(g2)),
+          adjacency_g2_(host_g2_->adjacency),
+          degrees_g1_(ComputeWeightedDegrees(g1, adjacency_g1_)),
+          degrees_g2_(host_g2_->weighted_degrees),
+          pool_(SortByDegreeDescending(degrees_g2_)),
+          images_(g1.GetVertices(), kUnmappedVertex),
+          taken_(g2.GetVertices(), false),
+          mapped_neighbours_(g1.GetVertices(), 0),
+          satisfied_(g2.GetVertices(), 0),
+          stamps_(g2.GetVertices(), 0)
+    {
+    }
+
+    /* Returns the cost of the built mapping */
+    int Run(SearchContext &ctx)
+    {
+        const std::vector<Vertex> roots = SortByDegreeDescending(degrees_g1_);
+
+        /* Max-heap of (mapped neighbours, degree, vertex) with lazy invalidation */
+        using Key = std::tuple<Vertices, std::uint64_t, Vertex>;
+        std::priority_queue<Key> queue;
+
+        int cost           = 0;
+        size_t next_root   = 0;
+        Vertices remaining = g1_.GetVertices();
+        while (remaining > 0) {
+            Vertex v1{};
+            if (!queue.empty()) {
+                const auto [count, degree, vertex] = queue.top();
+                queue.pop();
+                if (images_[vertex] != kUnmappedVertex || count != mapped_neighbours_[vertex]) {
+                    continue;
+                }
+                v1 = vertex;
+            } else {
+                while (images_[roots[next_root]] != kUnmappedVertex) {
+                    ++next_root;
+                }
+                v1 = roots[next_root];
+            }
+
+            if (remaining % 256 == 0) {
+                ctx.RecordExpansion(queue.size(), cost);
+            }
+
+            const auto [v2, assignment_cost] = PickImage_(v1);
+            images_[v1]                      = static_cast<MappedVertex>(v2);
+            taken_[v2]                       = true;
+            cost += assignment_cost;
+            --remaining;
+
+            for (const SparseAdjacency::Entry *entry = adjacency_g1_.Begin(v1); entry != adjacency_g1_.End(v1);
+                 ++entry) {
+                if (images_[entry->u] == kUnmappedVertex) {
+                    queue.emplace(++mapped_neighbours_[entry->u], degrees_g1_[entry->u], entry->u);
+                }
+            }
+        }
+        return cost;
+    }
+
+    NODISCARD Mapping GetMapping() const
+    {
+        Mapping mapping(g1_.GetVertices(), g2_.GetVertices());
+        for (Vertex v1 = 0; v1 < g1_.GetVertices(); ++v1) {
+            mapping.set_mapping(v1, static_cast<Vertex>(images_[v1]));
+        }
+        return mapping;
+    }
+
+    private:
+    /* Best free image of v1 together with the edges it adds towards the mapped vertices */
+    std::pair<Vertex, int> PickImage_(const Vertex v1)
+    {
+        std::uint64_t needed = 0;
+        touched_.clear();
+        ++step_;
+
+        for (const SparseAdjacency::Entry *entry = adjacency_g1_.Begin(v1); entry != adjacency_g1_.End(v1); ++entry) {
+            if (images_[entry->u] == kUnmappedVertex) {
+                continue;
+            }
+            needed += entry->out_edges + entry->in_edges;
+
+            /* w2 -> u2 in G2 serves v1 -> u1, u2 -> w2 serves u1 -> v1 */
+            const auto u2 = static_cast<Vertex>(images_[entry->u]);
+            for (const SparseAdjacency::Entry *edge = adjacency_g2_.Begin(u2); edge != adjacency_g2_.End(u2); ++edge) {
+                const Vertex w2 = edge->u;
+                if (taken_[w2]) {
+                    continue;
+                }
+                if (stamps_[w2] != step_) {
+                    stamps_[w2]    = step_;
+                    satisfied_[w2] = 0;
+                    touched_.push_back(w2);
+                }
+                satisfied_[w2] += Satisfied_(entry->out_edges, edge->in_edges) +
+                                  Satisfied_(entry->in_edges, edge->out_edges);
+            }
+        }
+
+        Vertex best_v2  = 0;
+        int best_cost   = INT_MAX;
+        const auto cost = [&](const Vertex v2) {
+            const Edges loop_needed = g1_.GetEdges(v1, v1);
+            const Edges loop_found  = g2_.GetEdges(v2, v2);
+            const std::uint64_t satisfied = stamps_[v2] == step_ ? satisfied_[v2] : 0;
+            return static_cast<int>(needed - satisfied) +
+                   (loop_needed > loop_found ? static_cast<int>(loop_needed - loop_found) : 0);
+        };
+
+        for (const Vertex v2 : touched_) {
+            const int candidate_cost = cost(v2);
+            if (candidate_cost < best_cost ||
+                (candidate_cost == best_cost && degrees_g2_[v2] > degrees_g2_[best_v2])) {
+                best_cost = candidate_cost;
+                best_v2   = v2;
+            }
+        }
+
+        /* No mapped neighbours, or none of their images has a free neighbour: take from the global pool */
+        if (best_cost == INT_MAX) {
+            while (taken_[pool_[next_pool_]]) {
+                ++next_pool_;
+            }
+            best_v2   = pool_[next_pool_];
+            best_cost = cost(best_v2);
+        }
+        return {best_v2, best_cost};
+    }
+
+    const Graph &g1_;
+    const Graph &g2_;
+    SparseAdjacency adjacency_g1_;
+    std::shared_ptr<const HostPreprocessing> host_g2_; /* Resident one when registered */
+    const SparseAdjacency &adjacency_g2_;
+    std::vector<std::uint64_t> degrees_g1_;
+    const std::vector<std::uint64_t> &degrees_g2_;
+    std::vector<Vertex> pool_;
+    size_t next_pool_{0};
+    std::vector<MappedVertex> images_;
+    std::vector<bool> taken_;
+    std::vector<Vertices> mapped_neighbours_;
+    std::vector<std::uint64_t> satisfied_; /* Valid where the stamp equals the current step */
+    std::vector<std::uint32_t> stamps_;
+    std::uint32_t step_{0};
+    std::vector<Vertex> touched_{};
+};
+
+// ------------------------------
+// Implementations
+// ------------------------------
+
+std::vector<Mapping> ApproxFrontier(const Graph &g1, const Graph &g2, const int k)
+{
+    SearchContext ctx{};
+    return ApproxFrontier(g1, g2, k, ctx);
+}
+
+std::vector<Mapping> ApproxFrontier(const Graph &g1, const Graph &g2, const int k, SearchContext &ctx)
+{
+    assert(k >= 1);
+    if (g1.GetVertices() > g2.GetVertices()) {
+        return {};
+    }
+
+    FrontierGreedy_ greedy(g1, g2);
+    const int cost        = greedy.Run(ctx);
+    const Mapping mapping = greedy.GetMapping();
+    assert(cost == CalculateMappingCost(g1, g2, mapping));
+
+    ctx.OfferIncumbent(mapping, cost);
+    return {mapping};
+}
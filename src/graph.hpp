@@ -18,7 +18,16 @@ class Graph
     public:
     explicit Graph(const Vertices num_vertices) : vertices_(num_vertices)
     {
-        neighbourhood_matrix_ = new Edges[num_vertices * num_vertices]{};
+        neighbourhood_matrix_ = new Edges[static_cast<std::size_t>(num_vertices) * num_vertices]{};
+    }
+
+    /* Copies a row-major adjacency matrix whose entries add up to num_edges */
+    Graph(const Vertices num_vertices, const Edges *matrix, const std::uint64_t num_edges)
+        : vertices_(static_cast<std::int32_t>(num_vertices)), num_edges_(static_cast<std::int32_t>(num_edges))
+    {
+        const std::size_t matrix_size = static_cast<std::size_t>(num_vertices) * num_vertices;
+        neighbourhood_matrix_         = new Edges[matrix_size];
+        std::copy(matrix, matrix + matrix_size, neighbourhood_matrix_);
     }
 
     ~Graph()
@@ -93,6 +102,9 @@ class Graph
 
     NODISCARD FUNC_INLINE Edges GetEdges(const Vertex u, const Vertex v) const { return GetEdges_(u, v); }
 
+    /* Multiplicities of the edges leaving u, indexed by the target */
+    NODISCARD FUNC_INLINE const Edges *GetRow(const Vertex u) const { return &GetEdges_(u, 0); }
+
     NODISCARD FUNC_INLINE Vertices GetVertices() const { return static_cast<Vertices>(vertices_); }
 
     NODISCARD FUNC_INLINE Edges GetEdges() const { return static_cast<Edges>(num_edges_); }
@@ -202,7 +214,7 @@ class Graph
         assert(u < static_cast<Vertex>(vertices_));
         assert(v < static_cast<Vertex>(vertices_));
 
-        return neighbourhood_matrix_[u * vertices_ + v];
+        return neighbourhood_matrix_[static_cast<std::size_t>(u) * vertices_ + v];
     }
 
     NODISCARD FUNC_INLINE const Edges &GetEdges_(const Vertex u, const Vertex v) const
@@ -210,7 +222,7 @@ class Graph
         assert(u < static_cast<Vertex>(vertices_));
         assert(v < static_cast<Vertex>(vertices_));
 
-        return neighbourhood_matrix_[u * vertices_ + v];
+        return neighbourhood_matrix_[static_cast<std::size_t>(u) * vertices_ + v];
     }
 
     std::int32_t vertices_{};
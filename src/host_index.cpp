@@ -0,0 +1,315 @@
+#include "host_index.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// ------------------------------
+// Index layout
+// ------------------------------
+
+static constexpr char kIndexMagic[8]         = {'B', 'J', 'G', '2', 'I', 'D', 'X', '\0'};
+static constexpr std::uint32_t kIndexVersion = 1;
+
+/* Every section starts at a multiple of this, so that it can be read in place */
+static constexpr std::size_t kSectionAlignment = 8;
+
+enum IndexSection_ : std::size_t {
+    kMatrixSection = 0,   /* Edges[n * n], row-major */
+    kDegreesSection,      /* uint64[n] weighted degrees */
+    kCsrOffsetsSection,   /* uint32[n + 1] */
+    kCsrEntriesSection,   /* SparseAdjacency::Entry[] */
+    kSelfLoopsSection,    /* Edges[n] */
+    kOutOffsetsSection,   /* uint64[n + 1] into the sorted out multiplicities */
+    kOutValuesSection,    /* Edges[] */
+    kInOffsetsSection,    /* uint64[n + 1] into the sorted in multiplicities */
+    kInValuesSection,     /* Edges[] */
+    kSectionCount,
+};
+
+struct IndexHeader_ {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t vertices;
+    std::uint64_t offsets[kSectionCount]; /* In bytes from the start of the file */
+    std::uint64_t sizes[kSectionCount];   /* In bytes */
+};
+
+static_assert(std::is_trivially_copyable_v<SparseAdjacency::Entry>);
+
+static std::size_t AlignSection_(const std::size_t position)
+{
+    return (position + kSectionAlignment - 1) / kSectionAlignment * kSectionAlignment;
+}
+
+// ------------------------------
+// Host preprocessing
+// ------------------------------
+
+std::vector<std::uint64_t> ComputeWeightedDegrees(const Graph &g, const SparseAdjacency &adjacency)
+{
+    std::vector<std::uint64_t> degrees(g.GetVertices(), 0);
+    for (Vertex v = 0; v < g.GetVertices(); ++v) {
+        degrees[v] = g.GetEdges(v, v);
+        for (const SparseAdjacency::Entry *entry = adjacency.Begin(v); entry != adjacency.End(v); ++entry) {
+            degrees[v] += entry->out_edges + entry->in_edges;
+        }
+    }
+    return degrees;
+}
+
+std::vector<std::uint64_t> ComputeWeightedDegrees(const Graph &g)
+{
+    std::vector<std::uint64_t> degrees(g.GetVertices(), 0);
+    for (Vertex v = 0; v < g.GetVertices(); ++v) {
+        for (Vertex u = 0; u < g.GetVertices(); ++u) {
+            const Edges edges = g.GetEdges(v, u);
+            degrees[v] += edges;
+            if (u != v) {
+                degrees[u] += edges;
+            }
+        }
+    }
+    return degrees;
+}
+
+std::vector<Vertex> SortByDegreeDescending(const std::vector<std::uint64_t> &degrees)
+{
+    std::vector<Vertex> order(degrees.size());
+    for (Vertex v = 0; v < order.size(); ++v) {
+        order[v] = v;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](const Vertex a, const Vertex b) {
+        return degrees[a] > degrees[b];
+    });
+    return order;
+}
+
+std::shared_ptr<const HostPreprocessing> ComputeHostPreprocessing(const Graph &g2)
+{
+    SparseAdjacency adjacency(g2);
+    std::vector<std::uint64_t> degrees = ComputeWeightedDegrees(g2, adjacency);
+    return std::make_shared<const HostPreprocessing>(
+        HostPreprocessing{ComputeSignatures(g2), std::move(adjacency), std::move(degrees)}
+    );
+}
+
+static std::mutex g_ResidentHostMutex{};
+static const Graph *g_ResidentHostGraph = nullptr;
+static std::shared_ptr<const HostPreprocessing> g_ResidentHost{};
+
+ResidentHostScope::ResidentHostScope(const Graph &g2, std::shared_ptr<const HostPreprocessing> preprocessing)
+{
+    std::lock_guard lock(g_ResidentHostMutex);
+    g_ResidentHostGraph = &g2;
+    g_ResidentHost      = std::move(preprocessing);
+}
+
+ResidentHostScope::~ResidentHostScope()
+{
+    std::lock_guard lock(g_ResidentHostMutex);
+    g_ResidentHostGraph = nullptr;
+    g_ResidentHost.reset();
+}
+
+std::shared_ptr<const HostPreprocessing> FindResidentHost(const Graph &g2)
+{
+    std::lock_guard lock(g_ResidentHostMutex);
+    return g_ResidentHostGraph == &g2 ? g_ResidentHost : nullptr;
+}
+
+// ------------------------------
+// Index file
+// ------------------------------
+
+void BuildHostIndex(const Graph &g2, const HostPreprocessing &preprocessing, const char *file)
+{
+    const Vertices n2 = g2.GetVertices();
+
+    std::vector<Edges> matrix(static_cast<std::size_t>(n2) * n2);
+    for (Vertex u = 0; u < n2; ++u) {
+        for (Vertex v = 0; v < n2; ++v) {
+            matrix[static_cast<std::size_t>(u) * n2 + v] = g2.GetEdges(u, v);
+        }
+    }
+
+    std::vector<Edges> self_loops(n2);
+    std::vector<std::uint64_t> out_offsets{0};
+    std::vector<std::uint64_t> in_offsets{0};
+    std::vector<Edges> out_values;
+    std::vector<Edges> in_values;
+    for (const MultiplicitySignature &signature : preprocessing.signatures) {
+        self_loops[out_offsets.size() - 1] = signature.self_loop;
+        out_values.insert(out_values.end(), signature.out_edges.begin(), signature.out_edges.end());
+        in_values.insert(in_values.end(), signature.in_edges.begin(), signature.in_edges.end());
+        out_offsets.push_back(out_values.size());
+        in_offsets.push_back(in_values.size());
+    }
+
+    const auto bytes = [](const auto &values) {
+        return std::make_pair(static_cast<const void *>(values.data()), values.size() * sizeof(values[0]));
+    };
+    const std::pair<const void *, std::size_t> sections[kSectionCount] = {
+        bytes(matrix),
+        bytes(preprocessing.weighted_degrees),
+        bytes(preprocessing.adjacency.GetOffsets()),
+        bytes(preprocessing.adjacency.GetEntries()),
+        bytes(self_loops),
+        bytes(out_offsets),
+        bytes(out_values),
+        bytes(in_offsets),
+        bytes(in_values),
+    };
+
+    IndexHeader_ header{};
+    std::memcpy(header.magic, kIndexMagic, sizeof(kIndexMagic));
+    header.version       = kIndexVersion;
+    header.vertices      = n2;
+    std::size_t position = AlignSection_(sizeof(IndexHeader_));
+    for (std::size_t section = 0; section < kSectionCount; ++section) {
+        header.offsets[section] = position;
+        header.sizes[section]   = sections[section].second;
+        position                = AlignSection_(position + sections[section].second);
+    }
+
+    std::ofstream stream(file, std::ios::binary | std::ios::trunc);
+    if (!stream.is_open()) {
+        throw std::runtime_error("Error: Could not open file for writing: " + std::string(file));
+    }
+
+    const char padding[kSectionAlignment] = {};
+    stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    std::size_t written = sizeof(header);
+    for (std::size_t section = 0; section < kSectionCount; ++section) {
+        stream.write(padding, static_cast<std::streamsize>(header.offsets[section] - written));
+        stream.write(
+            static_cast<const char *>(sections[section].first), static_cast<std::streamsize>(header.sizes[section])
+        );
+        written = header.offsets[section] + header.sizes[section];
+    }
+    if (!stream) {
+        throw std::runtime_error("Error writing index file: " + std::string(file));
+    }
+}
+
+HostIndex::HostIndex(const char *file)
+{
+    const int fd = open(file, O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open file for reading: " + std::string(file));
+    }
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(IndexHeader_)) {
+        close(fd);
+        throw std::runtime_error("Invalid index file: " + std::string(file));
+    }
+    size_ = static_cast<std::size_t>(info.st_size);
+
+    void *mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Could not map index file " + std::string(file) + ": " + std::strerror(errno));
+    }
+    data_ = static_cast<const std::uint8_t *>(mapping);
+
+    const auto &header = *reinterpret_cast<const IndexHeader_ *>(data_);
+    bool valid = std::memcmp(header.magic, kIndexMagic, sizeof(kIndexMagic)) == 0 && header.version == kIndexVersion;
+    for (std::size_t section = 0; valid && section < kSectionCount; ++section) {
+        valid = header.offsets[section] % kSectionAlignment == 0 && header.offsets[section] <= size_ &&
+                header.sizes[section] <= size_ - header.offsets[section];
+    }
+
+    const std::size_t n2 = header.vertices;
+    valid = valid && header.sizes[kMatrixSection] == n2 * n2 * sizeof(Edges) &&
+            header.sizes[kDegreesSection] == n2 * sizeof(std::uint64_t) &&
+            header.sizes[kCsrOffsetsSection] == (n2 + 1) * sizeof(std::uint32_t) &&
+            header.sizes[kSelfLoopsSection] == n2 * sizeof(Edges) &&
+            header.sizes[kOutOffsetsSection] == (n2 + 1) * sizeof(std::uint64_t) &&
+            header.sizes[kInOffsetsSection] == (n2 + 1) * sizeof(std::uint64_t);
+    /* The variable-length sections must end where their offset arrays say */
+    if (valid) {
+        const auto *csr_offsets = reinterpret_cast<const std::uint32_t *>(data_ + header.offsets[kCsrOffsetsSection]);
+        const auto *out_offsets = reinterpret_cast<const std::uint64_t *>(data_ + header.offsets[kOutOffsetsSection]);
+        const auto *in_offsets  = reinterpret_cast<const std::uint64_t *>(data_ + header.offsets[kInOffsetsSection]);
+        valid = header.sizes[kCsrEntriesSection] == csr_offsets[n2] * sizeof(SparseAdjacency::Entry) &&
+                header.sizes[kOutValuesSection] == out_offsets[n2] * sizeof(Edges) &&
+                header.sizes[kInValuesSection] == in_offsets[n2] * sizeof(Edges);
+    }
+    if (!valid) {
+        munmap(mapping, size_);
+        throw std::runtime_error("Invalid or incompatible index file: " + std::string(file));
+    }
+}
+
+HostIndex::~HostIndex() { munmap(const_cast<std::uint8_t *>(data_), size_); }
+
+bool HostIndex::IsIndexFile(const char *file)
+{
+    std::ifstream stream(file, std::ios::binary);
+    char magic[sizeof(kIndexMagic)] = {};
+    return stream.read(magic, sizeof(magic)) && std::memcmp(magic, kIndexMagic, sizeof(kIndexMagic)) == 0;
+}
+
+template <class T>
+const T *HostIndex::Section_(const std::size_t section) const
+{
+    return reinterpret_cast<const T *>(data_ + reinterpret_cast<const IndexHeader_ *>(data_)->offsets[section]);
+}
+
+Vertices HostIndex::GetVertices() const { return reinterpret_cast<const IndexHeader_ *>(data_)->vertices; }
+
+Graph HostIndex::LoadGraph() const
+{
+    const Vertices n2      = GetVertices();
+    const auto *degrees    = Section_<std::uint64_t>(kDegreesSection);
+    const auto *self_loops = Section_<Edges>(kSelfLoopsSection);
+
+    /* An edge between two vertices is in both of their degrees, a self-loop in one, so the total comes in O(n2) */
+    std::uint64_t twice_edges = 0;
+    for (Vertex v = 0; v < n2; ++v) {
+        twice_edges += degrees[v] + self_loops[v];
+    }
+    return Graph(n2, Section_<Edges>(kMatrixSection), twice_edges / 2);
+}
+
+std::shared_ptr<const HostPreprocessing> HostIndex::LoadPreprocessing() const
+{
+    const auto &header = *reinterpret_cast<const IndexHeader_ *>(data_);
+    const Vertices n2  = GetVertices();
+
+    const auto *self_loops  = Section_<Edges>(kSelfLoopsSection);
+    const auto *out_offsets = Section_<std::uint64_t>(kOutOffsetsSection);
+    const auto *out_values  = Section_<Edges>(kOutValuesSection);
+    const auto *in_offsets  = Section_<std::uint64_t>(kInOffsetsSection);
+    const auto *in_values   = Section_<Edges>(kInValuesSection);
+
+    std::vector<MultiplicitySignature> signatures(n2);
+    for (Vertex v = 0; v < n2; ++v) {
+        signatures[v].self_loop = self_loops[v];
+        signatures[v].out_edges.assign(out_values + out_offsets[v], out_values + out_offsets[v + 1]);
+        signatures[v].in_edges.assign(in_values + in_offsets[v], in_values + in_offsets[v + 1]);
+    }
+
+    const auto *csr_offsets = Section_<std::uint32_t>(kCsrOffsetsSection);
+    const auto *csr_entries = Section_<SparseAdjacency::Entry>(kCsrEntriesSection);
+    const std::size_t entries = header.sizes[kCsrEntriesSection] / sizeof(SparseAdjacency::Entry);
+    SparseAdjacency adjacency(
+        std::vector<std::uint32_t>(csr_offsets, csr_offsets + n2 + 1),
+        std::vector<SparseAdjacency::Entry>(csr_entries, csr_entries + entries)
+    );
+
+    const auto *degrees = Section_<std::uint64_t>(kDegreesSection);
+    return std::make_shared<const HostPreprocessing>(HostPreprocessing{
+        std::move(signatures), std::move(adjacency), std::vector<std::uint64_t>(degrees, degrees + n2)
+    });
+}
@@ -0,0 +1,86 @@
+#ifndef HOST_INDEX_HPP
+#define HOST_INDEX_HPP
+
+#include "graph.hpp"
+#include "local_search.hpp"
+#include "pair_bounds.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// ------------------------------
+// Host preprocessing
+// ------------------------------
+
+/* Everything the engines derive from G2 alone. Computed in O(|V2|^2) by a scan of the matrix, or loaded from an index
+ * file written by BuildHostIndex(). */
+struct HostPreprocessing {
+    std::vector<MultiplicitySignature> signatures;
+    SparseAdjacency adjacency;
+    std::vector<std::uint64_t> weighted_degrees; /* Edge multiplicities in both directions, self-loop counted once */
+};
+
+NODISCARD std::vector<std::uint64_t> ComputeWeightedDegrees(const Graph &g, const SparseAdjacency &adjacency);
+
+/* Same degrees from a scan of the matrix, for callers without a SparseAdjacency */
+NODISCARD std::vector<std::uint64_t> ComputeWeightedDegrees(const Graph &g);
+
+/* Vertices by decreasing degree, ties in vertex order */
+NODISCARD std::vector<Vertex> SortByDegreeDescending(const std::vector<std::uint64_t> &degrees);
+
+NODISCARD std::shared_ptr<const HostPreprocessing> ComputeHostPreprocessing(const Graph &g2);
+
+/* Preprocessing of the host graph kept resident by --index and --serve. Engines that find their G2 registered here use
+ * it instead of recomputing it. Only one host is registered at a time, the registration is dropped with the scope. */
+class ResidentHostScope
+{
+    public:
+    ResidentHostScope(const Graph &g2, std::shared_ptr<const HostPreprocessing> preprocessing);
+
+    ResidentHostScope(const ResidentHostScope &)            = delete;
+    ResidentHostScope &operator=(const ResidentHostScope &) = delete;
+
+    ~ResidentHostScope();
+};
+
+/* Null unless g2 is the registered host */
+NODISCARD std::shared_ptr<const HostPreprocessing> FindResidentHost(const Graph &g2);
+
+// ------------------------------
+// Index file
+// ------------------------------
+
+/* Writes G2 and its preprocessing to a binary index file, in the byte order of this machine */
+void BuildHostIndex(const Graph &g2, const HostPreprocessing &preprocessing, const char *file);
+
+/* Index file mapped into memory. The graph and the preprocessing are copied out of the mapping section by section,
+ * without parsing or rescanning the matrix. */
+class HostIndex
+{
+    public:
+    explicit HostIndex(const char *file);
+
+    HostIndex(const HostIndex &)            = delete;
+    HostIndex &operator=(const HostIndex &) = delete;
+
+    ~HostIndex();
+
+    /* Whether the file starts like an index, as opposed to a text graph */
+    NODISCARD static bool IsIndexFile(const char *file);
+
+    NODISCARD Vertices GetVertices() const;
+
+    NODISCARD Graph LoadGraph() const;
+
+    NODISCARD std::shared_ptr<const HostPreprocessing> LoadPreprocessing() const;
+
+    private:
+    template <class T>
+    NODISCARD const T *Section_(std::size_t section) const;
+
+    const std::uint8_t *data_{};
+    std::size_t size_{};
+};
+
+#endif  // HOST_INDEX_HPP
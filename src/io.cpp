@@ -170,6 +170,30 @@ static void PrintMappingTable(std::ostream &os, const Mapping &mapping, const Ve
 // Public API Implementations
 // ------------------------------
 
+Graph ReadGraph(std::istream &stream)
+{
+    Vertices size{};
+    stream >> size;
+    if (stream.fail() || size == 0) {
+        throw std::runtime_error("Error reading or invalid graph size.");
+    }
+
+    Graph g(size);
+    for (Vertex i = 0; i < size; ++i) {
+        for (Vertex j = 0; j < size; ++j) {
+            Edges edges{};
+            stream >> edges;
+            if (stream.fail()) {
+                throw std::runtime_error("Error reading adjacency matrix.");
+            }
+            if (edges > 0) {
+                g.AddEdges(i, j, edges);
+            }
+        }
+    }
+    return g;
+}
+
 std::pair<Graph, Graph> Read(const char *file)
 {
     std::ifstream file_stream(file);
@@ -177,31 +201,8 @@ std::pair<Graph, Graph> Read(const char *file)
         throw std::runtime_error("Could not open file for reading: " + std::string(file));
     }
 
-    auto read_single_graph = [](std::ifstream &fs) {
-        Vertices size{};
-        fs >> size;
-        if (fs.fail() || size == 0) {
-            throw std::runtime_error("Error reading or invalid graph size.");
-        }
-
-        Graph g(size);
-        for (Vertex i = 0; i < size; ++i) {
-            for (Vertex j = 0; j < size; ++j) {
-                Edges edges{};
-                fs >> edges;
-                if (fs.fail()) {
-                    throw std::runtime_error("Error reading adjacency matrix.");
-                }
-                if (edges > 0) {
-                    g.AddEdges(i, j, edges);
-                }
-            }
-        }
-        return g;
-    };
-
-    auto g1 = read_single_graph(file_stream);
-    auto g2 = read_single_graph(file_stream);
+    auto g1 = ReadGraph(file_stream);
+    auto g2 = ReadGraph(file_stream);
     return std::make_pair(std::move(g1), std::move(g2));
 }
 
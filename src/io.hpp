@@ -5,9 +5,12 @@
 #include "graph.hpp"
 
 #include <cstdint>
+#include <istream>
 #include <tuple>
 #include <vector>
 
+/* Single graph: vertex count followed by the adjacency matrix */
+Graph ReadGraph(std::istream &stream);
 std::pair<Graph, Graph> Read(const char *file);
 
 void Write(const Graph &g1, const Graph &g2, const std::vector<Mapping> &mappings, std::uint64_t time_spent);
@@ -0,0 +1,91 @@
+#include "local_search.hpp"
+
+#include <cassert>
+
+// ------------------------------
+// Implementations
+// ------------------------------
+
+SparseAdjacency::SparseAdjacency(const Graph &g) : offsets_(g.GetVertices() + 1, 0)
+{
+    for (Vertex v = 0; v < g.GetVertices(); ++v) {
+        offsets_[v] = static_cast<std::uint32_t>(entries_.size());
+        for (Vertex u = 0; u < g.GetVertices(); ++u) {
+            const Edges out_edges = g.GetEdges(v, u);
+            const Edges in_edges  = g.GetEdges(u, v);
+            if (u != v && (out_edges != 0 || in_edges != 0)) {
+                entries_.push_back(Entry{u, out_edges, in_edges});
+            }
+        }
+    }
+    offsets_[g.GetVertices()] = static_cast<std::uint32_t>(entries_.size());
+}
+
+int CalculateMappingCost(const Graph &g1, const Graph &g2, const Mapping &mapping)
+{
+    assert(mapping.get_mapped_count() == g1.GetVertices());
+    return MoveEvaluator(g1, g2, mapping).TotalCost();
+}
+
+RefineResult RefineMapping(const Graph &g1, const Graph &g2, Mapping &mapping, SearchContext &ctx)
+{
+    assert(mapping.get_mapped_count() == g1.GetVertices());
+
+    MoveEvaluator evaluator(g1, g2, mapping);
+    const int initial_cost = evaluator.TotalCost();
+
+    int cost                    = initial_cost;
+    std::uint64_t moves_applied = 0;
+    bool improved               = true;
+    while (improved && cost > 0 && !ctx.ShouldStop()) {
+        improved = false;
+
+        for (Vertex v1 = 0; v1 < g1.GetVertices() && !ctx.ShouldStop(); ++v1) {
+            ctx.RecordExpansion(0, cost);
+
+            /* Best move of v1: every other G2 vertex is either free (reassign) or owned by another vertex (swap) */
+            int best_delta  = 0;
+            Vertex best_v2  = 0;
+            const Vertex v2 = evaluator.GetImage(v1);
+            for (Vertex u2 = 0; u2 < g2.GetVertices(); ++u2) {
+                if (u2 == v2) {
+                    continue;
+                }
+
+                const MappedVertex owner = evaluator.GetOwner(u2);
+                const int delta          = owner == kUnmappedVertex
+                                               ? evaluator.ReassignDelta(v1, u2)
+                                               : evaluator.SwapDelta(v1, static_cast<Vertex>(owner));
+                if (delta < best_delta) {
+                    best_delta = delta;
+                    best_v2    = u2;
+                }
+            }
+
+            if (best_delta == 0) {
+                continue;
+            }
+
+            if (const MappedVertex owner = evaluator.GetOwner(best_v2); owner == kUnmappedVertex) {
+                evaluator.Reassign(v1, best_v2);
+            } else {
+                evaluator.Swap(v1, static_cast<Vertex>(owner));
+            }
+            cost += best_delta;
+            ++moves_applied;
+            improved = true;
+        }
+    }
+
+    assert(cost == evaluator.TotalCost());
+
+    /* Rebuild the mapping from scratch, as swaps would otherwise transiently unmap vertices */
+    Mapping refined(g1.GetVertices(), g2.GetVertices());
+    for (Vertex v1 = 0; v1 < g1.GetVertices(); ++v1) {
+        refined.set_mapping(v1, evaluator.GetImage(v1));
+    }
+    mapping = refined;
+
+    ctx.OfferIncumbent(mapping, cost);
+    return RefineResult{initial_cost, cost, moves_applied};
+}
@@ -0,0 +1,150 @@
+#ifndef LOCAL_SEARCH_HPP
+#define LOCAL_SEARCH_HPP
+
+#include "State.hpp"
+#include "graph.hpp"
+#include "search_context.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/* Neighbourhoods of all vertices of a graph in compressed form: edge multiplicities in both directions, self-loop
+ * excluded. Lets the local search evaluate a move in O(degree) instead of O(|V1|). */
+struct SparseAdjacency {
+    struct Entry {
+        Vertex u;
+        Edges out_edges; /* v -> u */
+        Edges in_edges;  /* u -> v */
+    };
+
+    explicit SparseAdjacency(const Graph &g);
+
+    /* Adopts arrays built earlier, e.g. loaded from a host index */
+    SparseAdjacency(std::vector<std::uint32_t> offsets, std::vector<Entry> entries)
+        : offsets_(std::move(offsets)), entries_(std::move(entries))
+    {
+    }
+
+    NODISCARD FUNC_INLINE const Entry *Begin(const Vertex v) const { return entries_.data() + offsets_[v]; }
+
+    NODISCARD FUNC_INLINE const Entry *End(const Vertex v) const { return entries_.data() + offsets_[v + 1]; }
+
+    NODISCARD const std::vector<std::uint32_t> &GetOffsets() const { return offsets_; }
+
+    NODISCARD const std::vector<Entry> &GetEntries() const { return entries_; }
+
+    private:
+    std::vector<std::uint32_t> offsets_;
+    std::vector<Entry> entries_;
+};
+
+/* Incremental cost model of a complete mapping. Moves only touch the rows and columns of the moved vertices, so both
+ * kinds of moves are evaluated in O(degree). */
+class MoveEvaluator
+{
+    public:
+    MoveEvaluator(const Graph &g1, const Graph &g2, const Mapping &mapping)
+        : g1_(g1), g2_(g2), adjacency_(g1), images_(g1.GetVertices()), owners_(g2.GetVertices(), kUnmappedVertex)
+    {
+        for (Vertex v1 = 0; v1 < g1.GetVertices(); ++v1) {
+            images_[v1]          = static_cast<Vertex>(mapping.get_mapping_g1_to_g2(v1));
+            owners_[images_[v1]] = static_cast<MappedVertex>(v1);
+        }
+    }
+
+    /* Cost of every pair containing v1 if it was mapped onto v2, the image of skip left out */
+    NODISCARD FUNC_INLINE int VertexCost(const Vertex v1, const Vertex v2, const Vertex skip) const
+    {
+        int cost = Deficit_(g1_.GetEdges(v1, v1), g2_.GetEdges(v2, v2));
+        for (const SparseAdjacency::Entry *entry = adjacency_.Begin(v1); entry != adjacency_.End(v1); ++entry) {
+            if (entry->u == skip) {
+                continue;
+            }
+            const Vertex u2 = images_[entry->u];
+            cost += Deficit_(entry->out_edges, g2_.GetEdges(v2, u2));
+            cost += Deficit_(entry->in_edges, g2_.GetEdges(u2, v2));
+        }
+        return cost;
+    }
+
+    NODISCARD FUNC_INLINE int ReassignDelta(const Vertex v1, const Vertex v2) const
+    {
+        return VertexCost(v1, v2, v1) - VertexCost(v1, images_[v1], v1);
+    }
+
+    /* The pair (v1, w1) is counted once, explicitly, on both sides */
+    NODISCARD FUNC_INLINE int SwapDelta(const Vertex v1, const Vertex w1) const
+    {
+        const Vertex a = images_[v1];
+        const Vertex b = images_[w1];
+
+        const int before = VertexCost(v1, a, w1) + VertexCost(w1, b, v1) + PairCost_(v1, w1, a, b);
+        const int after  = VertexCost(v1, b, w1) + VertexCost(w1, a, v1) + PairCost_(v1, w1, b, a);
+        return after - before;
+    }
+
+    void Reassign(const Vertex v1, const Vertex v2)
+    {
+        owners_[images_[v1]] = kUnmappedVertex;
+        owners_[v2]          = static_cast<MappedVertex>(v1);
+        images_[v1]          = v2;
+    }
+
+    void Swap(const Vertex v1, const Vertex w1)
+    {
+        std::swap(images_[v1], images_[w1]);
+        owners_[images_[v1]] = static_cast<MappedVertex>(v1);
+        owners_[images_[w1]] = static_cast<MappedVertex>(w1);
+    }
+
+    NODISCARD int TotalCost() const
+    {
+        int cost = 0;
+        for (Vertex v1 = 0; v1 < g1_.GetVertices(); ++v1) {
+            cost += Deficit_(g1_.GetEdges(v1, v1), g2_.GetEdges(images_[v1], images_[v1]));
+            for (const SparseAdjacency::Entry *entry = adjacency_.Begin(v1); entry != adjacency_.End(v1); ++entry) {
+                cost += Deficit_(entry->out_edges, g2_.GetEdges(images_[v1], images_[entry->u]));
+            }
+        }
+        return cost;
+    }
+
+    NODISCARD FUNC_INLINE Vertex GetImage(const Vertex v1) const { return images_[v1]; }
+
+    NODISCARD FUNC_INLINE MappedVertex GetOwner(const Vertex v2) const { return owners_[v2]; }
+
+    private:
+    static FUNC_INLINE int Deficit_(const Edges needed, const Edges found)
+    {
+        return needed > found ? static_cast<int>(needed - found) : 0;
+    }
+
+    NODISCARD FUNC_INLINE int PairCost_(const Vertex v1, const Vertex w1, const Vertex v2, const Vertex w2) const
+    {
+        return Deficit_(g1_.GetEdges(v1, w1), g2_.GetEdges(v2, w2)) +
+               Deficit_(g1_.GetEdges(w1, v1), g2_.GetEdges(w2, v2));
+    }
+
+    const Graph &g1_;
+    const Graph &g2_;
+    SparseAdjacency adjacency_;
+    std::vector<Vertex> images_;
+    std::vector<MappedVertex> owners_;
+};
+
+struct RefineResult {
+    int initial_cost;
+    int final_cost;
+    std::uint64_t moves_applied;
+};
+
+/* Hill-climbing over complete mappings. For every G1 vertex in turn the best of its moves is applied if it lowers
+ * the cost: reassigning the vertex to a free G2 vertex, or swapping its image with another G1 vertex. Stops at a
+ * local optimum or when the context says so. The mapping must be complete. */
+RefineResult RefineMapping(const Graph &g1, const Graph &g2, Mapping &mapping, SearchContext &ctx);
+
+/* Sum of the missing edge multiplicities over all pairs of G1 vertices under a complete mapping */
+NODISCARD int CalculateMappingCost(const Graph &g1, const Graph &g2, const Mapping &mapping);
+
+#endif  // LOCAL_SEARCH_HPP
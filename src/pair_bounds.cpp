@@ -0,0 +1,96 @@
+#include "pair_bounds.hpp"
+#include "host_index.hpp"
+
+#include <algorithm>
+#include <functional>
+
+// ------------------------------
+// Helpers
+// ------------------------------
+
+static int CalculateSortedDeficit_(const std::vector<Edges> &needed, const std::vector<Edges> &available)
+{
+    int cost = 0;
+    for (size_t idx = 0; idx < needed.size(); ++idx) {
+        const Edges found = idx < available.size() ? available[idx] : 0;
+        if (needed[idx] > found) {
+            cost += static_cast<int>(needed[idx] - found);
+        }
+    }
+    return cost;
+}
+
+/* Signatures of a registered host graph are taken as they are instead of being recomputed */
+static PairLowerBounds MakePairLowerBounds_(const Graph &g1, const Graph &g2)
+{
+    if (const auto host = FindResidentHost(g2); host != nullptr) {
+        return PairLowerBounds(ComputeSignatures(g1), host->signatures);
+    }
+    return PairLowerBounds(ComputeSignatures(g1), ComputeSignatures(g2));
+}
+
+// ------------------------------
+// Implementations
+// ------------------------------
+
+MultiplicitySignature ComputeSignature(const Graph &g, const Vertex v)
+{
+    MultiplicitySignature signature{{}, {}, g.GetEdges(v, v)};
+
+    g.IterateOutEdges(
+        [&](const Edges edges, const Vertex u) {
+            if (u != v) {
+                signature.out_edges.push_back(edges);
+            }
+        },
+        v
+    );
+    g.IterateInEdges(
+        [&](const Edges edges, const Vertex u) {
+            if (u != v) {
+                signature.in_edges.push_back(edges);
+            }
+        },
+        v
+    );
+
+    std::sort(signature.out_edges.begin(), signature.out_edges.end(), std::greater<>());
+    std::sort(signature.in_edges.begin(), signature.in_edges.end(), std::greater<>());
+    return signature;
+}
+
+std::vector<MultiplicitySignature> ComputeSignatures(const Graph &g)
+{
+    std::vector<MultiplicitySignature> signatures;
+    signatures.reserve(g.GetVertices());
+    for (Vertex v = 0; v < g.GetVertices(); ++v) {
+        signatures.push_back(ComputeSignature(g, v));
+    }
+    return signatures;
+}
+
+int CalculateSignatureBound(const MultiplicitySignature &sig1, const MultiplicitySignature &sig2)
+{
+    int cost = CalculateSortedDeficit_(sig1.out_edges, sig2.out_edges);
+    cost += CalculateSortedDeficit_(sig1.in_edges, sig2.in_edges);
+    if (sig1.self_loop > sig2.self_loop) {
+        cost += static_cast<int>(sig1.self_loop - sig2.self_loop);
+    }
+    return cost;
+}
+
+PairLowerBounds::PairLowerBounds(const Graph &g1, const Graph &g2) : PairLowerBounds(MakePairLowerBounds_(g1, g2)) {}
+
+PairLowerBounds::PairLowerBounds(
+    const std::vector<MultiplicitySignature> &sigs1, const std::vector<MultiplicitySignature> &sigs2
+)
+    : size_g1_(static_cast<Vertices>(sigs1.size())),
+      size_g2_(static_cast<Vertices>(sigs2.size())),
+      bounds_(sigs1.size() * sigs2.size())
+{
+    for (Vertex v1 = 0; v1 < size_g1_; ++v1) {
+        for (Vertex v2 = 0; v2 < size_g2_; ++v2) {
+            bounds_[static_cast<std::size_t>(v1) * size_g2_ + v2] = CalculateSignatureBound(sigs1[v1], sigs2[v2]);
+        }
+    }
+}
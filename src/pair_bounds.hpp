@@ -0,0 +1,47 @@
+#ifndef PAIR_BOUNDS_HPP
+#define PAIR_BOUNDS_HPP
+
+#include "graph.hpp"
+
+#include <vector>
+
+/* Edge multiplicities around a single vertex sorted in descending order, self-loop kept apart. */
+struct MultiplicitySignature {
+    std::vector<Edges> out_edges;
+    std::vector<Edges> in_edges;
+    Edges self_loop;
+};
+
+NODISCARD MultiplicitySignature ComputeSignature(const Graph &g, Vertex v);
+NODISCARD std::vector<MultiplicitySignature> ComputeSignatures(const Graph &g);
+
+/* Minimal number of edges that must be added around v1 when it is mapped onto v2, whatever the rest of the mapping.
+ * Pairing both sorted multiplicity vectors position by position is optimal, as max(0, a - b) is convex. */
+NODISCARD int CalculateSignatureBound(const MultiplicitySignature &sig1, const MultiplicitySignature &sig2);
+
+/* Static lower-bound cost matrix LB[v1][v2], computed once per solve. */
+class PairLowerBounds
+{
+    public:
+    PairLowerBounds(const Graph &g1, const Graph &g2);
+    PairLowerBounds(const std::vector<MultiplicitySignature> &sigs1, const std::vector<MultiplicitySignature> &sigs2);
+
+    NODISCARD FUNC_INLINE int Get(const Vertex v1, const Vertex v2) const
+    {
+        assert(v1 < size_g1_ && v2 < size_g2_);
+        return bounds_[static_cast<std::size_t>(v1) * size_g2_ + v2];
+    }
+
+    NODISCARD FUNC_INLINE const int *GetRow(const Vertex v1) const
+    {
+        assert(v1 < size_g1_);
+        return &bounds_[static_cast<std::size_t>(v1) * size_g2_];
+    }
+
+    private:
+    Vertices size_g1_;
+    Vertices size_g2_;
+    std::vector<int> bounds_;
+};
+
+#endif  // PAIR_BOUNDS_HPP
@@ -0,0 +1,49 @@
+#include "algos.hpp"
+#include "thread_pool.hpp"
+
+#include <vector>
+
+// ------------------------------
+// Implementations
+// ------------------------------
+
+std::vector<Mapping> AccuratePortfolio(const Graph &g1, const Graph &g2, const int k)
+{
+    SearchContext ctx{};
+    return AccuratePortfolio(g1, g2, k, ctx, false);
+}
+
+std::vector<Mapping> AccuratePortfolio(
+    const Graph &g1, const Graph &g2, const int k, SearchContext &ctx, const bool branch_and_bound
+)
+{
+    if (g1.GetVertices() > g2.GetVertices()) {
+        return {};
+    }
+
+    /* Whoever closes the gap between the incumbent and the lower bound of the exact engine stops the other side */
+    ctx.SetStopWhenProvenOptimal(true);
+
+    /* Approximate side: a quick beam for a first upper bound, then annealing from it until the race is over. Every
+     * improvement goes through the incumbent of the context, which the exact engine prunes against. */
+    TaskGroup approx(GetSharedThreadPool());
+    approx.Run([&] {
+        (void)ApproxAStar(g1, g2, k, ctx);
+        if (!ctx.ShouldStop()) {
+            (void)ApproxAnnealing(g1, g2, k, ctx);
+        }
+    });
+
+    /* Exact side on the calling thread, its lower bound is the only one that can prove optimality */
+    if (branch_and_bound) {
+        (void)AccurateBranchAndBound(g1, g2, k, ctx);
+    } else {
+        (void)AccurateAStar(g1, g2, k, ctx);
+    }
+    approx.Wait();
+
+    ctx.SetStopWhenProvenOptimal(false);
+
+    auto incumbent = ctx.GetIncumbent();
+    return incumbent.has_value() ? std::vector<Mapping>{*incumbent} : std::vector<Mapping>{};
+}
@@ -0,0 +1,189 @@
+#include "result_cache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// ------------------------------
+// Helpers
+// ------------------------------
+
+static constexpr const char *kCacheHeader    = "bajo_jajo-cache 1";
+static constexpr const char *kCacheExtension = ".map";
+
+static constexpr std::uint64_t kFnvOffset = 0xCBF29CE484222325ULL;
+static constexpr std::uint64_t kFnvPrime  = 0x100000001B3ULL;
+
+static FUNC_INLINE std::uint64_t MixWord_(std::uint64_t hash, const std::uint32_t word)
+{
+    for (int byte = 0; byte < 4; ++byte) {
+        hash ^= (word >> (8 * byte)) & 0xFF;
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+static std::uint64_t MixGraph_(std::uint64_t hash, const Graph &g)
+{
+    hash = MixWord_(hash, g.GetVertices());
+    for (Vertex u = 0; u < g.GetVertices(); ++u) {
+        for (Vertex v = 0; v < g.GetVertices(); ++v) {
+            hash = MixWord_(hash, g.GetEdges(u, v));
+        }
+    }
+    return hash;
+}
+
+static std::uint64_t HashString_(const std::string_view text)
+{
+    std::uint64_t hash = kFnvOffset;
+    for (const char symbol : text) {
+        hash ^= static_cast<unsigned char>(symbol);
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+// ------------------------------
+// Implementations
+// ------------------------------
+
+std::uint64_t HashGraph(const Graph &g) { return MixGraph_(kFnvOffset, g); }
+
+ResultCache::ResultCache(std::filesystem::path directory, const std::uint64_t max_bytes)
+    : directory_(std::move(directory)), max_bytes_(max_bytes)
+{
+    std::filesystem::create_directories(directory_);
+}
+
+std::string ResultCache::MakeKey(const Graph &g1, const std::uint64_t g2_hash, const std::string_view engine) const
+{
+    std::uint64_t pair_hash = MixGraph_(kFnvOffset, g1);
+    pair_hash               = MixWord_(pair_hash, static_cast<std::uint32_t>(g2_hash));
+    pair_hash               = MixWord_(pair_hash, static_cast<std::uint32_t>(g2_hash >> 32));
+
+    std::ostringstream key;
+    key << std::hex << std::setfill('0') << std::setw(16) << pair_hash << '-' << std::setw(16) << HashString_(engine);
+    return key.str();
+}
+
+std::filesystem::path ResultCache::GetEntryPath_(const std::string &key) const
+{
+    return directory_ / (key + kCacheExtension);
+}
+
+std::optional<Mapping> ResultCache::Lookup(const std::string &key, const Graph &g1, const Graph &g2)
+{
+    std::lock_guard lock(mutex_);
+
+    const std::filesystem::path path = GetEntryPath_(key);
+    std::ifstream entry(path);
+    if (!entry.is_open()) {
+        return std::nullopt;
+    }
+
+    /* The hash is not collision free, the sizes and edge counts catch most of the damage */
+    std::string header;
+    std::string stored_key;
+    Vertices n1{};
+    Vertices n2{};
+    Edges edges_g1{};
+    Edges edges_g2{};
+    std::getline(entry, header);
+    entry >> stored_key >> n1 >> n2 >> edges_g1 >> edges_g2;
+    if (!entry || header != kCacheHeader || stored_key != key || n1 != g1.GetVertices() || n2 != g2.GetVertices() ||
+        edges_g1 != g1.GetEdges() || edges_g2 != g2.GetEdges()) {
+        return std::nullopt;
+    }
+
+    Mapping mapping(n1, n2);
+    std::vector<bool> taken(n2, false);
+    for (Vertex v1 = 0; v1 < n1; ++v1) {
+        Vertex v2{};
+        if (!(entry >> v2) || v2 >= n2 || taken[v2]) {
+            return std::nullopt;
+        }
+        taken[v2] = true;
+        mapping.set_mapping(v1, v2);
+    }
+
+    std::error_code error;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+    return mapping;
+}
+
+void ResultCache::Store(const std::string &key, const Graph &g1, const Graph &g2, const Mapping &mapping)
+{
+    if (mapping.get_mapped_count() != g1.GetVertices()) {
+        return;
+    }
+
+    std::lock_guard lock(mutex_);
+
+    /* Written aside and renamed, so that a concurrent reader never sees half of an entry */
+    static std::atomic<std::uint64_t> sequence{0};
+    std::ostringstream temporary_name;
+    temporary_name << key << ".tmp." << std::this_thread::get_id() << '.' << sequence.fetch_add(1);
+    const std::filesystem::path temporary = directory_ / temporary_name.str();
+    {
+        std::ofstream entry(temporary);
+        if (!entry.is_open()) {
+            return;
+        }
+        entry << kCacheHeader << '\n'
+              << key << '\n'
+              << g1.GetVertices() << ' ' << g2.GetVertices() << ' ' << g1.GetEdges() << ' ' << g2.GetEdges() << '\n';
+        for (Vertex v1 = 0; v1 < g1.GetVertices(); ++v1) {
+            entry << mapping.get_mapping_g1_to_g2(v1) << (v1 + 1 == g1.GetVertices() ? '\n' : ' ');
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, GetEntryPath_(key), error);
+    if (error) {
+        std::filesystem::remove(temporary, error);
+        return;
+    }
+    Evict_();
+}
+
+void ResultCache::Evict_()
+{
+    struct Entry {
+        std::filesystem::file_time_type used;
+        std::uint64_t bytes;
+        std::filesystem::path path;
+    };
+
+    std::error_code error;
+    std::vector<Entry> entries;
+    std::uint64_t total_bytes = 0;
+    for (const auto &file : std::filesystem::directory_iterator(directory_, error)) {
+        if (!file.is_regular_file(error) || file.path().extension() != kCacheExtension) {
+            continue;
+        }
+        const std::uint64_t bytes = file.file_size(error);
+        entries.push_back(Entry{file.last_write_time(error), bytes, file.path()});
+        total_bytes += bytes;
+    }
+    if (total_bytes <= max_bytes_) {
+        return;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+        return a.used < b.used;
+    });
+    for (const Entry &entry : entries) {
+        if (total_bytes <= max_bytes_) {
+            break;
+        }
+        if (std::filesystem::remove(entry.path, error)) {
+            total_bytes -= entry.bytes;
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef RESULT_CACHE_HPP
+#define RESULT_CACHE_HPP
+
+#include "State.hpp"
+#include "graph.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/* Default size limit of the --cache directory */
+static constexpr std::uint64_t kDefaultCacheSizeMb = 256;
+
+/* Hash of the adjacency matrix, vertex count included. It is not invariant to relabelling: a relabelled graph is a
+ * different key. */
+NODISCARD std::uint64_t HashGraph(const Graph &g);
+
+/* Mappings found earlier, one file per key in a directory shared between processes. The key covers the graph pair
+ * and a description of the engine with its parameters. Files are replaced atomically by rename. A hit refreshes the
+ * modification time of its file. A store evicts the least recently used files until the directory fits the limit. */
+class ResultCache
+{
+    public:
+    ResultCache(std::filesystem::path directory, std::uint64_t max_bytes);
+
+    /* G2 comes as its HashGraph digest, so that a resident host is hashed once rather than on every request */
+    NODISCARD std::string MakeKey(const Graph &g1, std::uint64_t g2_hash, std::string_view engine) const;
+
+    /* The stored mapping if there is one for the key and it fits the graphs, a damaged entry counts as a miss */
+    NODISCARD std::optional<Mapping> Lookup(const std::string &key, const Graph &g1, const Graph &g2);
+
+    void Store(const std::string &key, const Graph &g1, const Graph &g2, const Mapping &mapping);
+
+    private:
+    NODISCARD std::filesystem::path GetEntryPath_(const std::string &key) const;
+
+    void Evict_();
+
+    std::filesystem::path directory_;
+    std::uint64_t max_bytes_;
+    std::mutex mutex_{};
+};
+
+#endif  // RESULT_CACHE_HPP
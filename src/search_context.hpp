@@ -0,0 +1,246 @@
+#ifndef SEARCH_CONTEXT_HPP
+#define SEARCH_CONTEXT_HPP
+
+#include "State.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <optional>
+
+// ------------------------------
+// Cancellation Token
+// ------------------------------
+
+/* Cooperative cancellation flag. Cancel() is async-signal-safe so it may be called from signal handlers. */
+class CancellationToken
+{
+    public:
+    void Cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+
+    NODISCARD bool IsCancelled() const { return cancelled_.load(std::memory_order_relaxed); }
+
+    private:
+    std::atomic<bool> cancelled_{false};
+};
+
+// ------------------------------
+// Progress Reporting
+// ------------------------------
+
+struct SearchProgress {
+    std::uint64_t nodes_expanded;
+    double nodes_per_second;
+    std::size_t open_size;
+    int best_f;
+    int incumbent_cost; /* INT_MAX if none */
+    double elapsed_seconds;
+};
+
+using ProgressCallback = std::function<void(const SearchProgress &)>;
+
+// ------------------------------
+// Search Context
+// ------------------------------
+
+/* Shared control block of a single solve: deadline, cancellation, best mapping found so far, proven lower bound
+ * and progress reporting. */
+class SearchContext
+{
+    /* Expansions between two progress clock reads */
+    static constexpr std::uint64_t kProgressCheckInterval = 1024;
+
+    public:
+    using Clock = std::chrono::steady_clock;
+
+    SearchContext() = default;
+
+    explicit SearchContext(const std::chrono::milliseconds time_limit) { SetTimeLimit(time_limit); }
+
+    SearchContext(const SearchContext &)            = delete;
+    SearchContext &operator=(const SearchContext &) = delete;
+
+    // ------------------------------
+    // Deadline
+    // ------------------------------
+
+    void SetTimeLimit(const std::chrono::milliseconds time_limit)
+    {
+        has_deadline_ = true;
+        deadline_     = Clock::now() + time_limit;
+    }
+
+    NODISCARD bool HasDeadline() const { return has_deadline_; }
+
+    NODISCARD bool IsDeadlineExpired() const { return has_deadline_ && Clock::now() >= deadline_; }
+
+    /* Zero once expired, max() without a deadline */
+    NODISCARD Clock::duration GetTimeRemaining() const
+    {
+        if (!has_deadline_) {
+            return Clock::duration::max();
+        }
+        return std::max(deadline_ - Clock::now(), Clock::duration::zero());
+    }
+
+    // ------------------------------
+    // Cancellation
+    // ------------------------------
+
+    void Cancel() { cancellation_token_.Cancel(); }
+
+    NODISCARD bool IsCancelled() const { return cancellation_token_.IsCancelled(); }
+
+    NODISCARD CancellationToken &GetCancellationToken() { return cancellation_token_; }
+
+    /* Polled by the engines in their expansion loops */
+    NODISCARD bool ShouldStop() const
+    {
+        return IsCancelled() || IsDeadlineExpired() ||
+               (stop_when_proven_optimal_.load(std::memory_order_relaxed) && IsIncumbentProvenOptimal());
+    }
+
+    /* Lets engines sharing the context stop as soon as one of them proves the incumbent optimal. Off by default, as
+     * engines collecting k mappings must not stop at the first optimal one. */
+    void SetStopWhenProvenOptimal(const bool stop) { stop_when_proven_optimal_.store(stop, std::memory_order_relaxed); }
+
+    // ------------------------------
+    // Incumbent
+    // ------------------------------
+
+    /* Stores the mapping if it is strictly better than the current incumbent. Returns true on improvement. */
+    bool OfferIncumbent(const Mapping &mapping, const int cost)
+    {
+        std::lock_guard lock(incumbent_mutex_);
+        if (cost >= incumbent_cost_.load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        incumbent_.emplace(mapping);
+        incumbent_cost_.store(cost, std::memory_order_release);
+        return true;
+    }
+
+    NODISCARD bool HasIncumbent() const { return GetIncumbentCost() != INT_MAX; }
+
+    NODISCARD int GetIncumbentCost() const { return incumbent_cost_.load(std::memory_order_acquire); }
+
+    NODISCARD std::optional<Mapping> GetIncumbent() const
+    {
+        std::lock_guard lock(incumbent_mutex_);
+        return incumbent_;
+    }
+
+    // ------------------------------
+    // Lower bound
+    // ------------------------------
+
+    /* Lower bounds only ever tighten: every reported value is a valid bound, so we keep the largest. */
+    void RaiseLowerBound(const int bound)
+    {
+        int current = lower_bound_.load(std::memory_order_relaxed);
+        while (bound > current && !lower_bound_.compare_exchange_weak(current, bound, std::memory_order_relaxed)) {
+        }
+    }
+
+    NODISCARD int GetLowerBound() const
+    {
+        return std::min(lower_bound_.load(std::memory_order_relaxed), GetIncumbentCost());
+    }
+
+    NODISCARD bool IsIncumbentProvenOptimal() const { return HasIncumbent() && GetLowerBound() >= GetIncumbentCost(); }
+
+    // ------------------------------
+    // Reporting
+    // ------------------------------
+
+    /* Async-signal-safe: only flips an atomic flag, consumed by the search loop. */
+    void RequestReport() { report_requested_.store(true, std::memory_order_relaxed); }
+
+    NODISCARD bool ConsumeReportRequest() { return report_requested_.exchange(false, std::memory_order_relaxed); }
+
+    void SetProgressCallback(ProgressCallback callback, const std::chrono::milliseconds interval)
+    {
+        progress_callback_ = std::move(callback);
+        progress_interval_ = interval;
+    }
+
+    NODISCARD std::uint64_t GetNodesExpanded() const { return nodes_expanded_.load(std::memory_order_relaxed); }
+
+    /* Called by the engines once per expanded node. Serves pending report requests and periodic progress. */
+    void RecordExpansion(const std::size_t open_size, const int best_f)
+    {
+        const std::uint64_t expanded = nodes_expanded_.fetch_add(1, std::memory_order_relaxed) + 1;
+
+        if (ConsumeReportRequest()) {
+            std::lock_guard lock(progress_mutex_);
+            Report(std::cerr);
+        }
+
+        if (!progress_callback_ || expanded % kProgressCheckInterval != 0) {
+            return;
+        }
+
+        std::lock_guard lock(progress_mutex_);
+        const auto now = Clock::now();
+        if (now - last_progress_ < progress_interval_) {
+            return;
+        }
+
+        const double elapsed       = std::chrono::duration<double>(now - start_).count();
+        const double since_last    = std::chrono::duration<double>(now - last_progress_).count();
+        const std::uint64_t window = expanded - last_progress_nodes_;
+
+        progress_callback_(SearchProgress{
+            expanded,
+            since_last > 0.0 ? static_cast<double>(window) / since_last : 0.0,
+            open_size,
+            best_f,
+            GetIncumbentCost(),
+            elapsed,
+        });
+
+        last_progress_       = now;
+        last_progress_nodes_ = expanded;
+    }
+
+    void Report(std::ostream &os) const
+    {
+        os << "Incumbent cost: ";
+        if (HasIncumbent()) {
+            os << GetIncumbentCost();
+        } else {
+            os << "none";
+        }
+        os << ", proven lower bound: " << GetLowerBound() << (IsIncumbentProvenOptimal() ? " (optimal)" : "")
+           << "\n";
+    }
+
+    private:
+    Clock::time_point start_{Clock::now()};
+    bool has_deadline_{false};
+    Clock::time_point deadline_{};
+    CancellationToken cancellation_token_{};
+    std::atomic<bool> stop_when_proven_optimal_{false};
+
+    mutable std::mutex incumbent_mutex_{};
+    std::optional<Mapping> incumbent_{};
+    std::atomic<int> incumbent_cost_{INT_MAX};
+    std::atomic<int> lower_bound_{0};
+
+    std::atomic<bool> report_requested_{false};
+
+    std::atomic<std::uint64_t> nodes_expanded_{0};
+    std::mutex progress_mutex_{};
+    ProgressCallback progress_callback_{};
+    std::chrono::milliseconds progress_interval_{1000};
+    Clock::time_point last_progress_{start_};
+    std::uint64_t last_progress_nodes_{0};
+};
+
+#endif  // SEARCH_CONTEXT_HPP
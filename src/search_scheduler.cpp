@@ -0,0 +1,170 @@
+#include "search_scheduler.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+SearchScheduler::SearchScheduler(const unsigned threads) : threads_(std::max(threads, 1U)) {}
+
+SearchScheduler::JobId SearchScheduler::Submit(SearchTask task)
+{
+    std::lock_guard lock(mutex_);
+    return Insert_(std::move(task), false);
+}
+
+void SearchScheduler::SubmitDetached(SearchTask task)
+{
+    std::lock_guard lock(mutex_);
+    (void)Insert_(std::move(task), true);
+}
+
+SearchScheduler::JobId SearchScheduler::Insert_(SearchTask task, const bool detached)
+{
+    JobId id = jobs_.size();
+    if (detached && !free_.empty()) {
+        id = free_.back();
+        free_.pop_back();
+        jobs_[id] = Job_{};
+    } else {
+        jobs_.emplace_back();
+    }
+
+    Job_ &job    = jobs_[id];
+    job.task     = std::move(task);
+    job.done     = job.task.IsDone();
+    job.detached = detached;
+    if (job.done && detached) {
+        free_.push_back(id);
+    }
+    changed_.notify_all();
+    return id;
+}
+
+void SearchScheduler::Suspend(const JobId job)
+{
+    std::lock_guard lock(mutex_);
+    jobs_.at(job).suspended = true;
+}
+
+void SearchScheduler::Resume(const JobId job)
+{
+    std::lock_guard lock(mutex_);
+    jobs_.at(job).suspended = false;
+    changed_.notify_all();
+}
+
+void SearchScheduler::Run()
+{
+    GetSharedThreadPool().ParallelFor(0, threads_, 1, [this](std::size_t, std::size_t) {
+        WorkerLoop_();
+    });
+}
+
+void SearchScheduler::Hold()
+{
+    std::lock_guard lock(mutex_);
+    held_ = true;
+}
+
+void SearchScheduler::Release()
+{
+    std::lock_guard lock(mutex_);
+    held_ = false;
+    changed_.notify_all();
+}
+
+bool SearchScheduler::IsDone(const JobId job) const
+{
+    std::lock_guard lock(mutex_);
+    return jobs_.at(job).done;
+}
+
+std::vector<Mapping> SearchScheduler::TakeResult(const JobId job)
+{
+    std::lock_guard lock(mutex_);
+    Job_ &entry = jobs_.at(job);
+    if (entry.error != nullptr) {
+        std::rethrow_exception(std::exchange(entry.error, nullptr));
+    }
+    return entry.task.TakeResult();
+}
+
+std::chrono::nanoseconds SearchScheduler::GetUsedTime(const JobId job) const
+{
+    std::lock_guard lock(mutex_);
+    return jobs_.at(job).used;
+}
+
+std::uint64_t SearchScheduler::GetSlices(const JobId job) const
+{
+    std::lock_guard lock(mutex_);
+    return jobs_.at(job).slices;
+}
+
+bool SearchScheduler::PickNext_(JobId &job) const
+{
+    bool found = false;
+    for (JobId id = 0; id < jobs_.size(); ++id) {
+        const Job_ &entry = jobs_[id];
+        if (entry.done || entry.running || entry.suspended) {
+            continue;
+        }
+        if (!found || entry.used < jobs_[job].used) {
+            job   = id;
+            found = true;
+        }
+    }
+    return found;
+}
+
+void SearchScheduler::WorkerLoop_()
+{
+    std::unique_lock lock(mutex_);
+    while (true) {
+        JobId id{};
+        if (!PickNext_(id)) {
+            /* A job running elsewhere may come back runnable, or submit more work */
+            if (running_ == 0 && !held_) {
+                changed_.notify_all();
+                return;
+            }
+            changed_.wait(lock);
+            continue;
+        }
+
+        Job_ &job   = jobs_[id];
+        job.running = true;
+        ++running_;
+        lock.unlock();
+
+        bool done                = false;
+        std::exception_ptr error = nullptr;
+        const auto slice_start   = std::chrono::steady_clock::now();
+        try {
+            done = job.task.Resume();
+        } catch (...) {
+            done  = true;
+            error = std::current_exception();
+        }
+        const auto slice_time = std::chrono::steady_clock::now() - slice_start;
+
+        /* The frame of a finished detached job goes away outside the lock, the job is still ours */
+        if (done && job.detached) {
+            job.task = SearchTask{};
+        }
+
+        lock.lock();
+        assert(running_ != 0);
+        --running_;
+        job.running = false;
+        job.done    = done;
+        job.error   = error;
+        job.used += std::chrono::duration_cast<std::chrono::nanoseconds>(slice_time);
+        ++job.slices;
+        if (done && job.detached) {
+            free_.push_back(id);
+        }
+        changed_.notify_all();
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef SEARCH_SCHEDULER_HPP
+#define SEARCH_SCHEDULER_HPP
+
+#include "State.hpp"
+#include "search_task.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+/* Time-slices resumable searches over a fixed number of threads of the shared pool. The next slice always goes to the
+ * runnable job that has used the least time so far (least attained service): short jobs finish ahead of long ones
+ * and the long ones share the threads evenly, however many of them there are. A suspended job keeps its frame and
+ * takes no slices until resumed. */
+class SearchScheduler
+{
+    public:
+    using JobId = std::size_t;
+
+    explicit SearchScheduler(unsigned threads);
+
+    SearchScheduler(const SearchScheduler &)            = delete;
+    SearchScheduler &operator=(const SearchScheduler &) = delete;
+
+    /* Safe to call from any thread, also while Run() is in progress */
+    JobId Submit(SearchTask task);
+
+    /* Submit for a job nobody asks about: once it finishes its frame is destroyed and its slot reused, so a
+     * long-lived scheduler does not grow with the jobs it has run */
+    void SubmitDetached(SearchTask task);
+
+    /* Takes effect at the end of the current slice of the job */
+    void Suspend(JobId job);
+
+    void Resume(JobId job);
+
+    /* Runs slices until no job is runnable, i.e. every job is done or suspended */
+    void Run();
+
+    /* While held, an idle Run() waits for new jobs instead of returning, for a scheduler fed by a server */
+    void Hold();
+
+    void Release();
+
+    NODISCARD bool IsDone(JobId job) const;
+
+    /* Result of a finished job, rethrows what its search threw */
+    NODISCARD std::vector<Mapping> TakeResult(JobId job);
+
+    NODISCARD std::chrono::nanoseconds GetUsedTime(JobId job) const;
+
+    NODISCARD std::uint64_t GetSlices(JobId job) const;
+
+    private:
+    struct Job_ {
+        SearchTask task;
+        std::chrono::nanoseconds used{};
+        std::uint64_t slices{};
+        bool suspended{};
+        bool running{};
+        bool done{};
+        bool detached{};
+        std::exception_ptr error{};
+    };
+
+    /* Call under the lock */
+    JobId Insert_(SearchTask task, bool detached);
+
+    /* Runnable job with the least used time, the oldest on ties. Call under the lock. */
+    NODISCARD bool PickNext_(JobId &job) const;
+
+    void WorkerLoop_();
+
+    unsigned threads_;
+    mutable std::mutex mutex_{};
+    std::condition_variable changed_{};
+    std::deque<Job_> jobs_{}; /* Deque, so that a running job is not moved by Submit() */
+    std::vector<JobId> free_{}; /* Slots of finished detached jobs */
+    unsigned running_{};
+    bool held_{};
+};
+
+#endif  // SEARCH_SCHEDULER_HPP
@@ -0,0 +1,105 @@
+#ifndef SEARCH_TASK_HPP
+#define SEARCH_TASK_HPP
+
+#include "State.hpp"
+#include "defines.hpp"
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <utility>
+#include <vector>
+
+/* Expansions between two suspensions of a resumable search, small enough to keep a slice around a millisecond on
+ * mid-sized instances */
+static constexpr std::uint64_t kDefaultSearchSlice = 256;
+
+/* Value of co_yield inside a search coroutine, it carries nothing */
+struct SearchYield {
+};
+
+/* Search running as a C++20 coroutine. The task is created suspended and every Resume() runs it until its next
+ * co_yield or its co_return. Everything the search needs lives in the coroutine frame, so a suspended task costs no
+ * thread and may be resumed from any thread, one at a time. Arguments are taken by reference: the graphs and the
+ * context must outlive the task. */
+class SearchTask
+{
+    public:
+    struct promise_type {
+        std::vector<Mapping> result{};
+        std::exception_ptr error{};
+
+        SearchTask get_return_object() { return SearchTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        std::suspend_always yield_value(SearchYield) noexcept { return {}; }
+
+        void return_value(std::vector<Mapping> mappings) { result = std::move(mappings); }
+
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    SearchTask() = default;
+
+    SearchTask(SearchTask &&other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    SearchTask &operator=(SearchTask &&other) noexcept
+    {
+        if (this != &other) {
+            Destroy_();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    SearchTask(const SearchTask &)            = delete;
+    SearchTask &operator=(const SearchTask &) = delete;
+
+    ~SearchTask() { Destroy_(); }
+
+    NODISCARD bool IsDone() const { return handle_ == nullptr || handle_.done(); }
+
+    /* Runs one slice. Returns true once the search has finished, rethrows what the search threw. */
+    bool Resume()
+    {
+        if (!IsDone()) {
+            handle_.resume();
+        }
+        if (handle_ != nullptr && handle_.promise().error != nullptr) {
+            std::rethrow_exception(std::exchange(handle_.promise().error, nullptr));
+        }
+        return IsDone();
+    }
+
+    /* Result of a finished search, empty before */
+    NODISCARD std::vector<Mapping> TakeResult()
+    {
+        return IsDone() && handle_ != nullptr ? std::move(handle_.promise().result) : std::vector<Mapping>{};
+    }
+
+    /* Resumes until done, the blocking engines are this */
+    NODISCARD std::vector<Mapping> Run()
+    {
+        while (!Resume()) {
+        }
+        return TakeResult();
+    }
+
+    private:
+    explicit SearchTask(const std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    void Destroy_()
+    {
+        if (handle_ != nullptr) {
+            handle_.destroy();
+            handle_ = nullptr;
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle_{};
+};
+
+#endif  // SEARCH_TASK_HPP
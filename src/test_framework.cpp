@@ -1,9 +1,31 @@
 #include "test_framework.hpp"
 #include "random_gen.hpp"
+#include "thread_pool.hpp"
 
+#include <array>
 #include <chrono>
 #include <iomanip>
 #include <iostream>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// ------------------------------
+// Algorithms
+// ------------------------------
+
+/* Indexed by PreciseAlgo and ApproxAlgo */
+static constexpr std::array kPreciseAlgos{
+    std::make_tuple(static_cast<SigT>(AccurateBruteForce), "Brute force"),
+    std::make_tuple(static_cast<SigT>(AccurateAStar), "A*"),
+    std::make_tuple(static_cast<SigT>(AccurateBranchAndBound), "DFBnB"),
+};
+
+static constexpr std::array kApproxAlgos{
+    std::make_tuple(static_cast<SigT>(ApproxAStar), "Approx A*"),
+    std::make_tuple(static_cast<SigT>(ApproxAStar5), "Approx A* - 5"),
+};
 
 // ------------------------------
 // Helpers
@@ -113,9 +135,17 @@ static void RunTest_(const CollT &cases, std::tuple<SigT, const char *> algo0, s
               << std::setw(20) << "Algo0_Time (ms)" << std::setw(20) << "Algo1_Time (ms)" << "\n";
     std::cout << std::string(140, '-') << "\n";
 
+    /* Generation runs on the shared pool, the solves stay sequential so that their timings are not disturbed */
+    std::vector<std::optional<std::pair<Graph, Graph>>> examples(cases.size());
+    GetSharedThreadPool().ParallelFor(0, cases.size(), 1, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t case_idx = begin; case_idx < end; ++case_idx) {
+            examples[case_idx].emplace(GenerateExample(cases[case_idx]));
+        }
+    });
+
     int idx = 0;
     for (const GraphSpec &spec : cases) {
-        const auto [g1, g2] = GenerateExample(spec);
+        const auto &[g1, g2] = *examples[idx];
 
         auto start_precise    = std::chrono::high_resolution_clock::now();
         auto precise_mappings = algo0_func(g1, g2, 1);
@@ -3,29 +3,19 @@
 
 #include "algos.hpp"
 
-#include <array>
-#include <tuple>
+#include <vector>
 
 enum class ApproxAlgo { kApproxAStar = 0, kApproxAStar5, kLast };
 
 enum class PreciseAlgo {
     kBruteForce = 0,
     kAStar,
+    kBranchAndBound,
     kLast,
 };
 
 using SigT = std::vector<Mapping> (*)(const Graph &, const Graph &, int);
 
-static constexpr std::array kPreciseAlgos{
-    std::make_tuple(AccurateBruteForce, "Brute force"),
-    std::make_tuple(AccurateAStar, "A*"),
-};
-
-static constexpr std::array kApproxAlgos{
-    std::make_tuple(ApproxAStar, "Approx A*"),
-    std::make_tuple(ApproxAStar5, "Approx A* - 5"),
-};
-
 void TestApproxOnPrecise(ApproxAlgo approx_algo, PreciseAlgo precise_algo);
 void TestPreciseOnPrecise(PreciseAlgo precise_algo, PreciseAlgo precise_algo1);
 void TestApproxOnApprox(ApproxAlgo approx_algo, ApproxAlgo approx_algo1);
@@ -0,0 +1,224 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+// ------------------------------
+// Helpers
+// ------------------------------
+
+/* Pool and deque of the worker running on this thread, null outside of any pool */
+static thread_local ThreadPool *tls_pool_ = nullptr;
+static thread_local unsigned tls_index_   = 0;
+
+// ------------------------------
+// Task Group
+// ------------------------------
+
+void TaskGroup::Run(std::function<void()> task)
+{
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    pool_.Submit_(ThreadPool::Task{std::move(task), this});
+
+    /* A waiter sleeping on this group may help with the new task */
+    std::lock_guard lock(mutex_);
+    done_.notify_all();
+}
+
+void TaskGroup::Wait()
+{
+    WaitNoThrow_();
+
+    std::lock_guard lock(mutex_);
+    if (error_ != nullptr) {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+}
+
+void TaskGroup::Execute_(const std::function<void()> &task)
+{
+    if (!IsCancelled()) {
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard lock(mutex_);
+            if (error_ == nullptr) {
+                error_ = std::current_exception();
+            }
+            Cancel();
+        }
+    }
+
+    /* Counted down under the lock: the waiter sees zero only under it too, so it cannot return and destroy the
+     * group while this task still touches the mutex or the condition variable */
+    std::lock_guard lock(mutex_);
+    if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        done_.notify_all();
+    }
+}
+
+void TaskGroup::WaitNoThrow_()
+{
+    std::unique_lock lock(mutex_);
+    while (pending_.load(std::memory_order_acquire) != 0) {
+        lock.unlock();
+        const bool ran = pool_.TryRunOne_();
+        lock.lock();
+        if (ran) {
+            continue;
+        }
+
+        done_.wait(lock, [&] {
+            return pending_.load(std::memory_order_acquire) == 0 || pool_.queued_.load(std::memory_order_acquire) != 0;
+        });
+    }
+}
+
+// ------------------------------
+// Thread Pool
+// ------------------------------
+
+ThreadPool::ThreadPool(const unsigned threads)
+{
+    const unsigned count = std::max(threads, 1U);
+    for (unsigned index = 0; index < count; ++index) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (unsigned index = 0; index < count; ++index) {
+        workers_.emplace_back([this, index] {
+            WorkerLoop_(index);
+        });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(sleep_mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread &worker : workers_) {
+        worker.join();
+    }
+    assert(queued_.load() == 0 && "pool destroyed with queued tasks");
+}
+
+void ThreadPool::ParallelFor(
+    const std::size_t begin, const std::size_t end, const std::size_t grain,
+    const std::function<void(std::size_t, std::size_t)> &body
+)
+{
+    const std::size_t step = std::max<std::size_t>(grain, 1);
+
+    TaskGroup group(*this);
+    for (std::size_t chunk = begin; chunk < end; chunk += step) {
+        const std::size_t chunk_end = std::min(end, chunk + step);
+        group.Run([&body, chunk, chunk_end] {
+            body(chunk, chunk_end);
+        });
+    }
+    group.Wait();
+}
+
+void ThreadPool::Submit_(Task task)
+{
+    /* Workers keep their own tasks local, which keeps nested groups on the thread that spawned them */
+    const unsigned index = tls_pool_ == this ? tls_index_
+                                             : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    /* Counted before it becomes visible, so a thief never takes the counter below zero */
+    queued_.fetch_add(1, std::memory_order_release);
+    {
+        std::lock_guard lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+
+    std::lock_guard lock(sleep_mutex_);
+    wake_.notify_one();
+}
+
+bool ThreadPool::TryPop_(Task &task)
+{
+    const bool is_worker = tls_pool_ == this;
+    const unsigned start = is_worker ? tls_index_ : 0;
+
+    if (is_worker) {
+        WorkerQueue &own = *queues_[start];
+        std::lock_guard lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    for (std::size_t offset = 0; offset < queues_.size(); ++offset) {
+        WorkerQueue &victim = *queues_[(start + offset) % queues_.size()];
+        std::lock_guard lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::TryRunOne_()
+{
+    Task task{};
+    if (!TryPop_(task)) {
+        return false;
+    }
+    queued_.fetch_sub(1, std::memory_order_acq_rel);
+    task.group->Execute_(task.fn);
+    return true;
+}
+
+void ThreadPool::WorkerLoop_(const unsigned index)
+{
+    tls_pool_  = this;
+    tls_index_ = index;
+
+    while (true) {
+        if (TryRunOne_()) {
+            continue;
+        }
+
+        std::unique_lock lock(sleep_mutex_);
+        wake_.wait(lock, [&] {
+            return stopping_ || queued_.load(std::memory_order_acquire) != 0;
+        });
+        if (stopping_ && queued_.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+// ------------------------------
+// Shared pool
+// ------------------------------
+
+static std::mutex g_SharedPoolMutex{};
+static std::unique_ptr<ThreadPool> g_SharedPool{};
+static unsigned g_SharedPoolSize = 0;
+
+ThreadPool &GetSharedThreadPool()
+{
+    std::lock_guard lock(g_SharedPoolMutex);
+    if (g_SharedPool == nullptr) {
+        const unsigned threads = g_SharedPoolSize != 0 ? g_SharedPoolSize : std::thread::hardware_concurrency();
+        g_SharedPool           = std::make_unique<ThreadPool>(threads);
+    }
+    return *g_SharedPool;
+}
+
+void SetSharedThreadPoolSize(const unsigned threads)
+{
+    std::lock_guard lock(g_SharedPoolMutex);
+    g_SharedPoolSize = threads;
+    if (g_SharedPool != nullptr && g_SharedPool->GetThreads() != std::max(threads, 1U)) {
+        g_SharedPool.reset();
+    }
+}
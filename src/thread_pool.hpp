@@ -0,0 +1,124 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include "defines.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool;
+
+// ------------------------------
+// Task Group
+// ------------------------------
+
+/* Set of tasks submitted to one pool that is waited for together. Wait() runs queued tasks of the pool while the
+ * group is not done, so waiting inside a task never blocks a worker and groups may nest freely. The first exception
+ * thrown by a task cancels the group and is rethrown from Wait(). */
+class TaskGroup
+{
+    public:
+    explicit TaskGroup(ThreadPool &pool) : pool_(pool) {}
+
+    TaskGroup(const TaskGroup &)            = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    /* A group must be waited for before it goes out of scope, its tasks refer to it */
+    ~TaskGroup() { WaitNoThrow_(); }
+
+    void Run(std::function<void()> task);
+
+    void Wait();
+
+    /* Tasks that did not start yet are skipped, running ones may poll IsCancelled() */
+    void Cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+
+    NODISCARD bool IsCancelled() const { return cancelled_.load(std::memory_order_relaxed); }
+
+    private:
+    friend class ThreadPool;
+
+    void Execute_(const std::function<void()> &task);
+
+    void WaitNoThrow_();
+
+    ThreadPool &pool_;
+    std::atomic<bool> cancelled_{false};
+    std::atomic<std::size_t> pending_{0};
+    std::mutex mutex_{};
+    std::condition_variable done_{};
+    std::exception_ptr error_{};
+};
+
+// ------------------------------
+// Thread Pool
+// ------------------------------
+
+/* Work-stealing pool: every worker owns a deque, pops its own newest task and steals the oldest task of another
+ * worker when its deque is empty. Tasks submitted from outside the pool are dealt to the workers round-robin. */
+class ThreadPool
+{
+    public:
+    explicit ThreadPool(unsigned threads);
+
+    ThreadPool(const ThreadPool &)            = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool();
+
+    NODISCARD unsigned GetThreads() const { return static_cast<unsigned>(workers_.size()); }
+
+    /* Calls body(begin, end) for consecutive chunks of [begin, end) of about grain indices, in parallel. The calling
+     * thread takes part and the call returns once every chunk is done. */
+    void ParallelFor(
+        std::size_t begin, std::size_t end, std::size_t grain,
+        const std::function<void(std::size_t, std::size_t)> &body
+    );
+
+    private:
+    friend class TaskGroup;
+
+    struct Task {
+        std::function<void()> fn;
+        TaskGroup *group;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex{};
+        std::deque<Task> tasks{};
+    };
+
+    void Submit_(Task task);
+
+    /* Runs one queued task if there is any, the caller's own deque first */
+    bool TryRunOne_();
+
+    bool TryPop_(Task &task);
+
+    void WorkerLoop_(unsigned index);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_{};
+    std::vector<std::thread> workers_{};
+    std::atomic<std::size_t> queued_{0};
+    std::atomic<unsigned> next_queue_{0};
+    std::mutex sleep_mutex_{};
+    std::condition_variable wake_{};
+    bool stopping_{false};
+};
+
+/* Pool shared by every engine and the test harness, created on first use. Sized by --threads through
+ * SetSharedThreadPoolSize(), the hardware concurrency by default. */
+ThreadPool &GetSharedThreadPool();
+
+/* Must not be called while the shared pool has work in flight */
+void SetSharedThreadPoolSize(unsigned threads);
+
+#endif  // THREAD_POOL_HPP
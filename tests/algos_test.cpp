@@ -1,6 +1,11 @@
 #include "algos.hpp"
 #include "graph.hpp"
 #include "gtest/gtest.h"
+#include "local_search.hpp"
+#include "random_gen.hpp"
+
+#include <chrono>
+#include <vector>
 
 // Test fixture for Algos tests
 class AlgosTest : public ::testing::Test
@@ -227,3 +232,363 @@ TEST_F(AlgosTest, GetMinimalExtension_NonIdentityMapping)
     EXPECT_EQ(extendedG2.GetEdges(2, 1), 4);  // (0, 1) in G1 maps to (2, 1) in G2
     EXPECT_EQ(extendedG2.GetEdges(1, 0), 6);  // (1, 2) in G1 maps to (1, 0) in G2
 }
+
+// ========================================
+// Anytime A* Tests
+// ========================================
+
+// A generous time limit must not change the optimal answer
+TEST_F(AlgosTest, AccurateAStar_TimeLimitFinishedIsOptimal)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{6, 8, 0.8, 2.0, true});
+
+    SearchContext ctx(std::chrono::milliseconds(60'000));
+    const auto anytime = AccurateAStar(g1, g2, 1, ctx);
+    const auto exact   = AccurateBruteForce(g1, g2, 1);
+
+    ASSERT_EQ(anytime.size(), 1);
+    ASSERT_EQ(exact.size(), 1);
+    EXPECT_EQ(CalculateMappingCost(g1, g2, anytime[0]), CalculateMappingCost(g1, g2, exact[0]));
+    EXPECT_EQ(ctx.GetIncumbentCost(), CalculateMappingCost(g1, g2, exact[0]));
+    EXPECT_TRUE(ctx.IsIncumbentProvenOptimal());
+}
+
+// An expired deadline still yields a complete mapping with consistent bounds
+TEST_F(AlgosTest, AccurateAStar_TimeLimitExpiredReturnsIncumbent)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{14, 16, 30, 40.0, false});
+
+    SearchContext ctx(std::chrono::milliseconds(1));
+    const auto mappings = AccurateAStar(g1, g2, 1, ctx);
+
+    ASSERT_EQ(mappings.size(), 1);
+    EXPECT_EQ(mappings[0].get_mapped_count(), g1.GetVertices());
+    EXPECT_EQ(ctx.GetIncumbentCost(), CalculateMappingCost(g1, g2, mappings[0]));
+    EXPECT_LE(ctx.GetLowerBound(), ctx.GetIncumbentCost());
+}
+
+// ========================================
+// Cancellation Tests
+// ========================================
+
+// Every engine stops on a cancelled context and still returns a complete mapping
+TEST_F(AlgosTest, Engines_CancelledReturnCompleteMapping)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{9, 12, 20, 10.0, false});
+
+    using EngineT = std::vector<Mapping> (*)(const Graph &, const Graph &, int, SearchContext &);
+    for (const EngineT engine :
+         {static_cast<EngineT>(AccurateAStar), static_cast<EngineT>(AccurateBruteForce),
+          static_cast<EngineT>(ApproxAStar)}) {
+        SearchContext ctx{};
+        ctx.Cancel();
+
+        const auto mappings = engine(g1, g2, 1, ctx);
+        ASSERT_EQ(mappings.size(), 1);
+        EXPECT_EQ(mappings[0].get_mapped_count(), g1.GetVertices());
+        EXPECT_EQ(ctx.GetIncumbentCost(), CalculateMappingCost(g1, g2, mappings[0]));
+    }
+}
+
+// Progress callback fires while the search runs. The instance takes several thousand expansions to solve, a few
+// times the 1024 expansions between two progress checks.
+TEST_F(AlgosTest, AccurateAStar_ProgressCallback)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{8, 10, 1.0, 1.0, false});
+
+    SearchContext ctx{};
+    int calls = 0;
+    ctx.SetProgressCallback(
+        [&](const SearchProgress &progress) {
+            EXPECT_GT(progress.nodes_expanded, 0);
+            calls++;
+        },
+        std::chrono::milliseconds(0)
+    );
+
+    const auto mappings = AccurateAStar(g1, g2, 1, ctx);
+    ASSERT_EQ(mappings.size(), 1);
+    ASSERT_GE(ctx.GetNodesExpanded(), 1024);
+    EXPECT_GT(calls, 0);
+}
+
+// A weighted cycle as G1: every vertex ties with its neighbours, so a set of pairs could be reached in several orders.
+// Without a closed list the search must still find the optimum, and expand no partial mapping of its one G1 order
+// twice, which keeps it within the number of such mappings.
+TEST_F(AlgosTest, AccurateAStar_SymmetricG1NeedsNoClosedList)
+{
+    for (const Vertices size_g1 : {5U, 6U, 7U}) {
+        Graph g1(size_g1);
+        for (Vertex v = 0; v < size_g1; ++v) {
+            g1.AddEdges(v, (v + 1) % size_g1, 2);
+        }
+        const auto [unused, g2] = GenerateExample(GraphSpec{1, size_g1 + 2, 0.3, 0.3, false});
+
+        SearchContext ctx{};
+        const auto mappings = AccurateAStar(g1, g2, 1, ctx);
+        const auto optimum  = AccurateBruteForce(g1, g2, 1);
+        ASSERT_EQ(mappings.size(), 1);
+        ASSERT_EQ(optimum.size(), 1);
+        EXPECT_EQ(CalculateMappingCost(g1, g2, mappings[0]), CalculateMappingCost(g1, g2, optimum[0]));
+
+        std::uint64_t partial_mappings = 0;
+        std::uint64_t at_depth         = 1;
+        for (Vertices depth = 0; depth < size_g1; ++depth) {
+            partial_mappings += at_depth;
+            at_depth *= g2.GetVertices() - depth;
+        }
+        EXPECT_LE(ctx.GetNodesExpanded(), partial_mappings);
+    }
+}
+
+// ========================================
+// Branch and Bound Tests
+// ========================================
+
+// DFBnB must find the same optimal cost as the exhaustive search
+TEST_F(AlgosTest, AccurateBranchAndBound_MatchesBruteForce)
+{
+    for (const GraphSpec &spec : {
+             GraphSpec{5, 5, 1.0, 2.0, true},
+             GraphSpec{6, 8, 0.8, 2.0, true},
+             GraphSpec{8, 8, 2.5, 0.5, false},
+             GraphSpec{7, 8, 30.0, 35.0, false},
+         }) {
+        const auto [g1, g2] = GenerateExample(spec);
+
+        const auto bnb   = AccurateBranchAndBound(g1, g2, 1);
+        const auto exact = AccurateBruteForce(g1, g2, 1);
+
+        ASSERT_EQ(bnb.size(), 1);
+        ASSERT_EQ(exact.size(), 1);
+        EXPECT_EQ(bnb[0].get_mapped_count(), g1.GetVertices());
+        EXPECT_EQ(CalculateMappingCost(g1, g2, bnb[0]), CalculateMappingCost(g1, g2, exact[0]));
+    }
+}
+
+// ========================================
+// Beam Width Tests
+// ========================================
+
+// An explicit width equal to the default one reproduces the default search
+TEST_F(AlgosTest, ApproxAStar_ExplicitBeamWidthMatchesDefault)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{19, 25, 0.3, 0.4, true});
+
+    SearchContext default_ctx{};
+    SearchContext explicit_ctx{};
+    const auto by_default  = ApproxAStar(g1, g2, 1, default_ctx);
+    const auto by_explicit = ApproxAStar(g1, g2, 1, explicit_ctx, GetDefaultBeamWidth(g2.GetVertices()));
+
+    ASSERT_EQ(by_default.size(), 1);
+    ASSERT_EQ(by_explicit.size(), 1);
+    EXPECT_EQ(CalculateMappingCost(g1, g2, by_default[0]), CalculateMappingCost(g1, g2, by_explicit[0]));
+}
+
+// The automatic width must fit the deadline and still produce a complete mapping
+TEST_F(AlgosTest, ApproxAStar_AutoBeamWidthWithinDeadline)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{30, 40, 0.5, 0.6, true});
+
+    const auto start = std::chrono::steady_clock::now();
+    SearchContext ctx(std::chrono::milliseconds(500));
+    const auto mappings = ApproxAStar(g1, g2, 1, ctx, kAutoBeamWidth);
+    const auto elapsed  = std::chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(mappings.size(), 1);
+    EXPECT_EQ(mappings[0].get_mapped_count(), g1.GetVertices());
+    EXPECT_LT(elapsed, std::chrono::milliseconds(2000));
+}
+
+// ========================================
+// Parallel Beam Tests
+// ========================================
+
+// The level-synchronous beam returns the same mapping whatever the number of threads
+TEST_F(AlgosTest, ApproxAStarParallel_DeterministicAcrossThreadCounts)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{25, 32, 0.5, 0.6, true});
+
+    SearchContext serial_ctx{};
+    const auto serial = ApproxAStarParallel(g1, g2, 1, serial_ctx, 8, 1);
+    ASSERT_EQ(serial.size(), 1);
+    EXPECT_EQ(serial[0].get_mapped_count(), g1.GetVertices());
+    EXPECT_EQ(serial_ctx.GetIncumbentCost(), CalculateMappingCost(g1, g2, serial[0]));
+
+    /* One expansion per parent: at most a full beam on each level but the last */
+    EXPECT_GT(serial_ctx.GetNodesExpanded(), 0);
+    EXPECT_LE(serial_ctx.GetNodesExpanded(), static_cast<std::uint64_t>(g1.GetVertices()) * 8);
+
+    for (const unsigned threads : {2U, 3U, 8U}) {
+        SearchContext ctx{};
+        const auto parallel = ApproxAStarParallel(g1, g2, 1, ctx, 8, threads);
+        ASSERT_EQ(parallel.size(), 1);
+        EXPECT_EQ(ctx.GetNodesExpanded(), serial_ctx.GetNodesExpanded());
+        for (Vertex v = 0; v < g1.GetVertices(); ++v) {
+            EXPECT_EQ(parallel[0].get_mapping_g1_to_g2(v), serial[0].get_mapping_g1_to_g2(v));
+        }
+    }
+}
+
+// A cancelled parallel search still produces a complete mapping
+TEST_F(AlgosTest, ApproxAStarParallel_CancelledReturnsCompleteMapping)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{9, 12, 20, 10.0, false});
+
+    SearchContext ctx{};
+    ctx.Cancel();
+    const auto mappings = ApproxAStarParallel(g1, g2, 1, ctx, kDefaultBeamWidth, 4);
+
+    ASSERT_EQ(mappings.size(), 1);
+    EXPECT_EQ(mappings[0].get_mapped_count(), g1.GetVertices());
+}
+
+TEST_F(AlgosTest, ApproxAStarMultiStart_NeverWorseThanSingleRun)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{10, 14, 1.2, 0.8, false});
+
+    SearchContext single_ctx{};
+    const auto single = ApproxAStar(g1, g2, 1, single_ctx, 3);
+
+    SearchContext ctx{};
+    const auto mappings = ApproxAStarMultiStart(g1, g2, 1, ctx, 3, 4);
+
+    ASSERT_EQ(mappings.size(), 1);
+    EXPECT_EQ(mappings[0].get_mapped_count(), g1.GetVertices());
+    EXPECT_LE(ctx.GetIncumbentCost(), single_ctx.GetIncumbentCost());
+    EXPECT_EQ(ctx.GetIncumbentCost(), CalculateMappingCost(g1, g2, mappings[0]));
+}
+
+TEST_F(AlgosTest, ApproxAStarMultiStart_RestartsUntilDeadline)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{8, 11, 1.5, 1.0, false});
+
+    SearchContext ctx(std::chrono::milliseconds(300));
+    const auto start    = std::chrono::steady_clock::now();
+    const auto mappings = ApproxAStarMultiStart(g1, g2, 1, ctx, 2, 2);
+    const auto elapsed  = std::chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(mappings.size(), 1);
+    EXPECT_EQ(mappings[0].get_mapped_count(), g1.GetVertices());
+    EXPECT_LT(elapsed, std::chrono::milliseconds(3'000));
+
+    // Workers restart until the deadline, unless a zero-cost mapping ends the search first
+    EXPECT_TRUE(ctx.IsDeadlineExpired() || ctx.IsIncumbentProvenOptimal());
+}
+
+TEST_F(AlgosTest, ApproxAStarMultiStart_EmptyG1)
+{
+    const Graph g1(0);
+    Graph g2(4);
+    g2.AddEdges(0, 1);
+
+    SearchContext ctx(std::chrono::milliseconds(100));
+    const auto mappings = ApproxAStarMultiStart(g1, g2, 1, ctx, 2, 2);
+
+    ASSERT_EQ(mappings.size(), 1);
+    EXPECT_EQ(mappings[0].get_mapped_count(), 0);
+}
+
+TEST_F(AlgosTest, AccuratePortfolio_ProvesExactOptimum)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{7, 10, 1.5, 1.0, false});
+
+    const auto exact = AccurateAStar(g1, g2, 1);
+    ASSERT_EQ(exact.size(), 1);
+
+    for (const bool branch_and_bound : {false, true}) {
+        SearchContext ctx{};
+        const auto mappings = AccuratePortfolio(g1, g2, 1, ctx, branch_and_bound);
+
+        ASSERT_EQ(mappings.size(), 1);
+        EXPECT_EQ(CalculateMappingCost(g1, g2, mappings[0]), CalculateMappingCost(g1, g2, exact[0]));
+        EXPECT_TRUE(ctx.IsIncumbentProvenOptimal());
+    }
+}
+
+TEST_F(AlgosTest, AccuratePortfolio_StopsEveryoneOnProof)
+{
+    // G1 embeds into G2, so a zero-cost mapping ends the race as soon as anyone finds it
+    const auto [g1, g2] = GenerateExample(GraphSpec{14, 18, 0.5, 0.6, true});
+
+    SearchContext ctx(std::chrono::milliseconds(20'000));
+    const auto start    = std::chrono::steady_clock::now();
+    const auto mappings = AccuratePortfolio(g1, g2, 1, ctx, true);
+    const auto elapsed  = std::chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(mappings.size(), 1);
+    EXPECT_EQ(CalculateMappingCost(g1, g2, mappings[0]), 0);
+    EXPECT_TRUE(ctx.IsIncumbentProvenOptimal());
+    EXPECT_LT(elapsed, std::chrono::milliseconds(10'000));
+}
+
+TEST_F(AlgosTest, ApproxAStar_CandidateLimitReturnsCompleteMapping)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{12, 20, 1.0, 0.6, false});
+
+    for (const std::uint32_t candidates : {1U, 3U, 40U}) {
+        SearchContext ctx{};
+        const auto mappings = ApproxAStar(g1, g2, 1, ctx, 4, candidates);
+
+        ASSERT_EQ(mappings.size(), 1);
+        EXPECT_EQ(mappings[0].get_mapped_count(), g1.GetVertices());
+        EXPECT_EQ(ctx.GetIncumbentCost(), CalculateMappingCost(g1, g2, mappings[0]));
+    }
+}
+
+TEST_F(AlgosTest, ApproxAStar_TwoStageScoringAgainstFullScoring)
+{
+    // Widths 1 to 3 fully evaluate 3 to 9 children per expansion, out of up to 18
+    int two_stage_total = 0;
+    int full_total      = 0;
+    for (const double density : {0.3, 0.5, 0.8}) {
+        for (std::uint32_t size_g1 = 6; size_g1 <= 10; ++size_g1) {
+            for (std::uint32_t size_g2 = 12; size_g2 <= 18; ++size_g2) {
+                const auto [g1, g2] = GenerateExample(GraphSpec{size_g1, size_g2, density, density, size_g2 % 2 == 0});
+
+                for (const std::uint32_t width : {1U, 2U, 3U}) {
+                    SearchContext two_stage_ctx{};
+                    const auto two_stage = ApproxAStar(g1, g2, 1, two_stage_ctx, width);
+                    SearchContext full_ctx{};
+                    const auto full = ApproxAStar(g1, g2, 1, full_ctx, width, kAllCandidates, kScoreAllChildren);
+
+                    ASSERT_EQ(two_stage.size(), 1);
+                    ASSERT_EQ(full.size(), 1);
+                    ASSERT_EQ(two_stage[0].get_mapped_count(), g1.GetVertices());
+                    std::vector<bool> used(g2.GetVertices(), false);
+                    for (Vertex v1 = 0; v1 < g1.GetVertices(); ++v1) {
+                        const Vertex v2 = two_stage[0].get_mapping_g1_to_g2(v1);
+                        ASSERT_LT(v2, g2.GetVertices());
+                        EXPECT_FALSE(used[v2]);
+                        used[v2] = true;
+                    }
+                    EXPECT_EQ(two_stage_ctx.GetIncumbentCost(), CalculateMappingCost(g1, g2, two_stage[0]));
+
+                    two_stage_total += CalculateMappingCost(g1, g2, two_stage[0]);
+                    full_total += CalculateMappingCost(g1, g2, full[0]);
+                }
+            }
+        }
+    }
+
+    // Single instances go either way, as a cheaper child may lead somewhere worse, but over the sweep the cut must
+    // not cost anything
+    EXPECT_LE(two_stage_total, full_total);
+}
+
+TEST_F(AlgosTest, ApproxAStar_TwoStageScoringIsExactWithoutCut)
+{
+    // Width 6 evaluates 18 children, more than any expansion of a 14-vertex G2 has
+    const auto [g1, g2] = GenerateExample(GraphSpec{9, 14, 0.5, 0.5, false});
+
+    SearchContext two_stage_ctx{};
+    const auto two_stage = ApproxAStar(g1, g2, 1, two_stage_ctx, 6);
+    SearchContext full_ctx{};
+    const auto full = ApproxAStar(g1, g2, 1, full_ctx, 6, kAllCandidates, kScoreAllChildren);
+
+    ASSERT_EQ(two_stage.size(), 1);
+    ASSERT_EQ(full.size(), 1);
+    for (Vertex v1 = 0; v1 < g1.GetVertices(); ++v1) {
+        EXPECT_EQ(two_stage[0].get_mapping_g1_to_g2(v1), full[0].get_mapping_g1_to_g2(v1));
+    }
+}
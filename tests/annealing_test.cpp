@@ -0,0 +1,55 @@
+#include "algos.hpp"
+#include "gtest/gtest.h"
+#include "local_search.hpp"
+#include "random_gen.hpp"
+
+#include <chrono>
+
+TEST(AnnealingTest, ReturnsCompleteMappingWithOfferedCost)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{30, 45, 0.6, 0.5, false});
+
+    SearchContext ctx{};
+    const auto mappings = ApproxAnnealing(g1, g2, 1, ctx);
+    ASSERT_EQ(mappings.size(), 1);
+    EXPECT_EQ(mappings[0].get_mapped_count(), g1.GetVertices());
+    EXPECT_EQ(ctx.GetIncumbentCost(), CalculateMappingCost(g1, g2, mappings[0]));
+}
+
+TEST(AnnealingTest, NeverWorseThanSeedIncumbent)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{25, 35, 0.5, 0.6, true});
+
+    const auto seed     = ApproxAStar(g1, g2, 1);
+    const int seed_cost = CalculateMappingCost(g1, g2, seed[0]);
+
+    SearchContext ctx(std::chrono::milliseconds(300));
+    ctx.OfferIncumbent(seed[0], seed_cost);
+
+    const auto mappings = ApproxAnnealing(g1, g2, 1, ctx);
+    ASSERT_EQ(mappings.size(), 1);
+    EXPECT_LE(CalculateMappingCost(g1, g2, mappings[0]), seed_cost);
+}
+
+TEST(AnnealingTest, RespectsDeadlineOnLargeInstance)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{400, 600, 0.02, 0.03, false});
+
+    SearchContext ctx(std::chrono::milliseconds(200));
+    const auto start    = std::chrono::steady_clock::now();
+    const auto mappings = ApproxAnnealing(g1, g2, 1, ctx);
+    const auto elapsed  = std::chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(mappings.size(), 1);
+    EXPECT_EQ(mappings[0].get_mapped_count(), g1.GetVertices());
+    EXPECT_LT(elapsed, std::chrono::milliseconds(2'000));
+    EXPECT_EQ(ctx.GetIncumbentCost(), CalculateMappingCost(g1, g2, mappings[0]));
+}
+
+TEST(AnnealingTest, LargerG1HasNoMapping)
+{
+    const auto [g2, g1] = GenerateExample(GraphSpec{6, 9, 0.5, 0.5, false});
+
+    SearchContext ctx{};
+    EXPECT_TRUE(ApproxAnnealing(g1, g2, 1, ctx).empty());
+}
@@ -0,0 +1,328 @@
+#include "algos.hpp"
+#include "app.hpp"
+#include "gtest/gtest.h"
+#include "io.hpp"
+#include "local_search.hpp"
+#include "random_gen.hpp"
+#include "thread_pool.hpp"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+// ------------------------------
+// Helpers
+// ------------------------------
+
+/* Vertex count followed by the adjacency matrix, the format of an input file and of a --serve request */
+static std::string GraphText_(const Graph &g)
+{
+    std::ostringstream text;
+    text << g.GetVertices() << "\n";
+    for (Vertex u = 0; u < g.GetVertices(); ++u) {
+        for (Vertex v = 0; v < g.GetVertices(); ++v) {
+            text << g.GetEdges(u, v) << (v + 1 == g.GetVertices() ? "\n" : " ");
+        }
+    }
+    return text.str();
+}
+
+static std::vector<std::string> ReadLines_(const std::filesystem::path &file)
+{
+    std::ifstream stream(file);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(stream, line);) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+static std::vector<std::string> SplitTabs_(const std::string &line)
+{
+    std::vector<std::string> fields;
+    std::istringstream stream(line);
+    for (std::string field; std::getline(stream, field, '\t');) {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+/* Connects to the unix socket, retrying while the server starts up. Returns -1 if it never comes up. */
+static int Connect_(const std::filesystem::path &socket_path)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+
+    const auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (std::chrono::steady_clock::now() < give_up) {
+        const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0) {
+            return fd;
+        }
+        close(fd);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    return -1;
+}
+
+/* Sends as much of the request as the server takes, half-closes when asked to and reads the response to the end */
+static std::string Exchange_(const std::filesystem::path &socket_path, const std::string &request, bool half_close)
+{
+    const int fd = Connect_(socket_path);
+    if (fd < 0) {
+        return "";
+    }
+
+    std::size_t sent = 0;
+    while (sent < request.size()) {
+        const ssize_t written = send(fd, request.data() + sent, request.size() - sent, MSG_NOSIGNAL);
+        if (written <= 0) {
+            break;
+        }
+        sent += static_cast<std::size_t>(written);
+    }
+    if (half_close) {
+        shutdown(fd, SHUT_WR);
+    }
+
+    std::string response;
+    char buffer[4096];
+    for (ssize_t received; (received = recv(fd, buffer, sizeof(buffer), 0)) > 0;) {
+        response.append(buffer, static_cast<std::size_t>(received));
+    }
+    close(fd);
+    return response;
+}
+
+// ------------------------------
+// Fixture
+// ------------------------------
+
+/* Runs the app end to end in a scratch directory of its own */
+class AppRunTest : public ::testing::Test
+{
+    protected:
+    void SetUp() override
+    {
+        g_AppState = AppState{};
+        dir_       = std::filesystem::temp_directory_path() /
+               ("app_run_test_" + std::to_string(getpid()) + "_" +
+                ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override
+    {
+        g_AppState = AppState{};
+        std::filesystem::remove_all(dir_);
+
+        /* Run() sized the shared pool by --threads, the other tests expect the default */
+        SetSharedThreadPoolSize(0);
+    }
+
+    /* Starts --serve with host as G2 on a thread of its own, stopped by StopServer_() */
+    void StartServer_(const Graph &host)
+    {
+        host_file_   = (dir_ / "host.txt").string();
+        socket_file_ = (dir_ / "serve.sock").string();
+        std::ofstream(host_file_) << GraphText_(host);
+
+        g_AppState.serve_socket = socket_file_.c_str();
+        g_AppState.serve_host   = host_file_.c_str();
+        server_                 = std::thread([] {
+            EXPECT_NO_THROW(::Run());
+        });
+    }
+
+    void StopServer_()
+    {
+        EXPECT_EQ(Exchange_(socket_file_, "shutdown\n", true), "ok\n");
+        server_.join();
+    }
+
+    std::filesystem::path dir_{};
+    std::string host_file_{};
+    std::string socket_file_{};
+    std::thread server_{};
+};
+
+// ------------------------------
+// Batch
+// ------------------------------
+
+TEST_F(AppRunTest, Batch_WritesOutputsAndSummaryRows)
+{
+    const std::filesystem::path inputs = dir_ / "in";
+    const std::filesystem::path output = dir_ / "out";
+    std::filesystem::create_directories(inputs);
+
+    const auto first  = GenerateExample(GraphSpec{6, 9, 0.5, 0.6, false});
+    const auto second = GenerateExample(GraphSpec{7, 10, 0.4, 0.5, true});
+    const auto larger = GenerateExample(GraphSpec{5, 3, 0.5, 0.5, false});
+    Write((inputs / "a.txt").c_str(), first);
+    Write((inputs / "b.txt").c_str(), second);
+    Write((inputs / "c.txt").c_str(), larger);
+    std::ofstream(inputs / "d.txt") << "not a graph\n";
+
+    g_AppState.run_approx   = true;
+    g_AppState.batch        = inputs.c_str();
+    g_AppState.batch_output = output.c_str();
+    testing::internal::CaptureStdout();
+    ASSERT_NO_THROW(::Run());
+    (void)testing::internal::GetCapturedStdout();
+
+    const std::vector<std::string> summary = ReadLines_(output / "summary.tsv");
+    ASSERT_EQ(summary.size(), 5);
+    EXPECT_EQ(summary[0], "input\tstatus\tcost\ttime_ms\toutput");
+
+    /* One row per input in name order: two solved, one without a mapping, one that does not parse */
+    const std::vector<std::tuple<Graph, Graph>> solved{first, second};
+    for (std::size_t row = 0; row < solved.size(); ++row) {
+        const std::vector<std::string> fields = SplitTabs_(summary[row + 1]);
+        ASSERT_EQ(fields.size(), 5);
+        const auto &[g1, g2]  = solved[row];
+        const std::string stem = row == 0 ? "a" : "b";
+
+        EXPECT_EQ(fields[0], (inputs / (stem + ".txt")).string());
+        EXPECT_EQ(fields[1], "ok");
+        EXPECT_EQ(std::stoi(fields[2]), CalculateMappingCost(g1, g2, ApproxAStar(g1, g2, 1)[0]));
+        EXPECT_EQ(fields[4], (output / (stem + ".out")).string());
+        EXPECT_TRUE(std::filesystem::is_regular_file(fields[4]));
+    }
+
+    const std::vector<std::string> no_mapping = SplitTabs_(summary[3]);
+    ASSERT_EQ(no_mapping.size(), 5);
+    EXPECT_EQ(no_mapping[1], "no-mapping");
+    EXPECT_EQ(no_mapping[2], "-1");
+
+    const std::vector<std::string> failed = SplitTabs_(summary[4]);
+    ASSERT_EQ(failed.size(), 5);
+    EXPECT_EQ(failed[0], (inputs / "d.txt").string());
+    EXPECT_EQ(failed[1].rfind("error: ", 0), 0) << failed[1];
+    EXPECT_EQ(failed[2], "-1");
+    EXPECT_FALSE(std::filesystem::exists(output / "d.out"));
+}
+
+TEST_F(AppRunTest, Batch_MemoryLimitAdmitsOneInputAtATime)
+{
+    const std::filesystem::path inputs = dir_ / "in";
+    std::filesystem::create_directories(inputs);
+    Write((inputs / "a_slow.txt").c_str(), GenerateExample(GraphSpec{14, 16, 30, 40.0, false}));
+    Write((inputs / "b_quick.txt").c_str(), GenerateExample(GraphSpec{3, 5, 0.5, 0.5, false}));
+
+    /* Exact search, which runs into the time limit on the slow input. On one thread the quick input overtakes it,
+     * unless the resident size is over --memory-limit, which a 1 MiB limit always is. */
+    const auto first_finished = [&](const std::uint64_t memory_limit_mb) {
+        const std::filesystem::path output = dir_ / ("out_" + std::to_string(memory_limit_mb));
+        g_AppState                         = AppState{};
+        g_AppState.time_limit_ms           = 300;
+        g_AppState.memory_limit_mb         = memory_limit_mb;
+        g_AppState.batch                   = inputs.c_str();
+        g_AppState.batch_output            = output.c_str();
+
+        testing::internal::CaptureStdout();
+        EXPECT_NO_THROW(::Run());
+        const std::string log = testing::internal::GetCapturedStdout();
+
+        const std::vector<std::string> summary = ReadLines_(output / "summary.tsv");
+        EXPECT_EQ(summary.size(), 3);
+        if (summary.size() == 3) {
+            EXPECT_EQ(SplitTabs_(summary[1])[1], "timeout");
+            EXPECT_EQ(SplitTabs_(summary[2])[1], "ok");
+        }
+
+        const std::size_t first = log.find("[1/2] ");
+        return first == std::string::npos ? std::string{} : log.substr(first + 6, log.find(':', first) - first - 6);
+    };
+
+    EXPECT_EQ(first_finished(0), (inputs / "b_quick.txt").string());
+    EXPECT_EQ(first_finished(1), (inputs / "a_slow.txt").string());
+}
+
+// ------------------------------
+// Serve
+// ------------------------------
+
+TEST_F(AppRunTest, Serve_AnswersRequestsAndErrors)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{6, 10, 0.5, 0.5, false});
+    StartServer_(g2);
+
+    /* "ok <cost> <time ms>" and the G2 image of every G1 vertex */
+    std::istringstream response(Exchange_(socket_file_, "solve approx 1 0\n" + GraphText_(g1), true));
+    std::string status;
+    int cost{};
+    double time_ms{};
+    response >> status >> cost >> time_ms;
+    ASSERT_EQ(status, "ok");
+    EXPECT_GE(time_ms, 0.0);
+
+    Mapping mapping(g1.GetVertices(), g2.GetVertices());
+    std::set<Vertex> images;
+    for (Vertex v1 = 0; v1 < g1.GetVertices(); ++v1) {
+        Vertex v2{};
+        ASSERT_TRUE(response >> v2);
+        ASSERT_LT(v2, g2.GetVertices());
+        images.insert(v2);
+        mapping.set_mapping(v1, v2);
+    }
+    EXPECT_EQ(images.size(), g1.GetVertices());
+    EXPECT_EQ(cost, CalculateMappingCost(g1, g2, mapping));
+    EXPECT_EQ(cost, CalculateMappingCost(g1, g2, ApproxAStar(g1, g2, 1)[0]));
+
+    EXPECT_EQ(Exchange_(socket_file_, "solve\n", true).rfind("error Malformed solve header", 0), 0);
+    EXPECT_EQ(
+        Exchange_(socket_file_, "solve teleport 1 0\n" + GraphText_(g1), true), "error Unknown engine teleport\n"
+    );
+    EXPECT_EQ(Exchange_(socket_file_, "hello\n", true), "error Unknown command hello\n");
+
+    StopServer_();
+    EXPECT_FALSE(std::filesystem::exists(socket_file_));
+}
+
+TEST_F(AppRunTest, Serve_RefusesRequestsOverTheSizeCap)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{4, 6, 0.5, 0.5, false});
+    StartServer_(g2);
+
+    /* One byte over kServeMaxRequestBytes of app.cpp */
+    std::string request = "solve approx 1 0\n";
+    request.resize(std::size_t{256} * 1024 * 1024 + 1, ' ');
+    EXPECT_EQ(Exchange_(socket_file_, request, true).rfind("error Request larger than", 0), 0);
+
+    /* The server keeps answering */
+    EXPECT_EQ(Exchange_(socket_file_, "solve approx 1 0\n" + GraphText_(g1), true).rfind("ok ", 0), 0);
+    StopServer_();
+}
+
+TEST_F(AppRunTest, Serve_TimesOutUnfinishedRequests)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{4, 6, 0.5, 0.5, false});
+    g_AppState.serve_timeout_ms = 300;
+    StartServer_(g2);
+
+    /* Never half-closed, so the request does not end before the timeout */
+    const auto start           = std::chrono::steady_clock::now();
+    const std::string response = Exchange_(socket_file_, "solve approx 1 0\n", false);
+    const auto elapsed         = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(response, "error Request not received within 300 ms\n");
+    EXPECT_GE(elapsed, std::chrono::milliseconds(300));
+    EXPECT_LT(elapsed, std::chrono::milliseconds(5'000));
+
+    /* The server keeps answering after dropping the silent client */
+    EXPECT_EQ(Exchange_(socket_file_, "solve approx 1 0\n" + GraphText_(g1), true).rfind("ok ", 0), 0);
+    StopServer_();
+}
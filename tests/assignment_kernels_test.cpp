@@ -0,0 +1,89 @@
+#include "assignment_kernels.hpp"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/* Sizes around the vector width and the bitset word, so that every tail is hit */
+static const std::vector<Vertices> kSizes = {1, 7, 8, 9, 63, 64, 65, 130};
+
+TEST(AssignmentKernelsTest, AddEdgeDeficitsMatchesScalar)
+{
+    std::mt19937 generator(kSeed);
+    std::uniform_int_distribution<Edges> pick_edges(0, 4);
+
+    for (const Vertices size : kSizes) {
+        std::vector<Edges> found_out(size);
+        std::vector<Edges> found_in(size);
+        std::vector<int> costs(size);
+        for (Vertex u = 0; u < size; ++u) {
+            found_out[u] = pick_edges(generator);
+            found_in[u]  = pick_edges(generator);
+            costs[u]     = static_cast<int>(u);
+        }
+
+        std::vector<int> expected = costs;
+        for (Vertex u = 0; u < size; ++u) {
+            const int deficit_out = std::max(0, 3 - static_cast<int>(found_out[u]));
+            const int deficit_in  = std::max(0, 2 - static_cast<int>(found_in[u]));
+            expected[u] += deficit_out + deficit_in;
+        }
+        AddEdgeDeficits(costs.data(), found_out.data(), 3, found_in.data(), 2, size);
+        EXPECT_EQ(costs, expected) << "size " << size;
+
+        /* A side that needs nothing is not read */
+        AddEdgeDeficits(costs.data(), nullptr, 0, found_in.data(), 1, size);
+        for (Vertex u = 0; u < size; ++u) {
+            expected[u] += found_in[u] == 0 ? 1 : 0;
+        }
+        EXPECT_EQ(costs, expected) << "size " << size;
+    }
+}
+
+TEST(AssignmentKernelsTest, PruneAndMinimumMatchScalar)
+{
+    std::mt19937 generator(kSeed);
+    std::uniform_int_distribution<int> pick_cost(0, 20);
+
+    for (const Vertices size : kSizes) {
+        const Vertices words = (size + 63) / 64;
+        std::vector<int> costs(size);
+        std::vector<int> bounds(size);
+        std::vector<std::uint64_t> bits(words, 0);
+        for (Vertex u = 0; u < size; ++u) {
+            costs[u]  = pick_cost(generator);
+            bounds[u] = pick_cost(generator);
+            if (generator() % 3 != 0) {
+                bits[u / 64] |= std::uint64_t{1} << (u % 64);
+            }
+        }
+
+        const auto is_set = [&](const Vertex u) {
+            return ((bits[u / 64] >> (u % 64)) & 1) != 0;
+        };
+
+        int expected_min = INT_MAX;
+        for (Vertex u = 0; u < size; ++u) {
+            if (is_set(u)) {
+                expected_min = std::min(expected_min, costs[u] + std::max(0, bounds[u] - costs[u]) / 2);
+            }
+        }
+        EXPECT_EQ(MinBlendedCost(bits.data(), costs.data(), bounds.data(), size), expected_min) << "size " << size;
+
+        std::vector<bool> expected_kept(size);
+        for (Vertex u = 0; u < size; ++u) {
+            expected_kept[u] = is_set(u) && std::max(costs[u], bounds[u]) < 12;
+        }
+        PruneOverBudget(bits.data(), costs.data(), bounds.data(), 12, size);
+        for (Vertex u = 0; u < size; ++u) {
+            EXPECT_EQ(is_set(u), expected_kept[u]) << "size " << size << " vertex " << u;
+        }
+    }
+
+    const std::uint64_t empty = 0;
+    const int value           = 0;
+    EXPECT_EQ(MinBlendedCost(&empty, &value, &value, 1), INT_MAX);
+}
@@ -0,0 +1,126 @@
+#include "beam.hpp"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+TEST(BeamTest, PoolRecyclesReleasedSlots)
+{
+    NodePool<std::vector<int>> pool;
+    const NodeHandle a = pool.Acquire();
+    const NodeHandle b = pool.Acquire();
+    EXPECT_NE(a, b);
+
+    pool.Get(a).assign(16, 1);
+    pool.Release(a);
+    EXPECT_EQ(pool.GetLiveCount(), 1);
+
+    // The slot comes back with its buffer still allocated
+    const NodeHandle c = pool.Acquire();
+    EXPECT_EQ(c, a);
+    EXPECT_GE(pool.Get(c).capacity(), 16);
+}
+
+TEST(BeamTest, HeapKeepsBestEntriesWithinCapacity)
+{
+    BeamHeap heap(3);
+    EXPECT_FALSE(heap.Insert(5, 0).has_value());
+    EXPECT_FALSE(heap.Insert(1, 1).has_value());
+    EXPECT_FALSE(heap.Insert(3, 2).has_value());
+    EXPECT_TRUE(heap.IsFull());
+    EXPECT_EQ(heap.PeekBestF(), 1);
+    EXPECT_EQ(heap.PeekWorstF(), 5);
+
+    // Not better than the worst entry: rejected
+    EXPECT_EQ(heap.Insert(5, 3), std::optional<NodeHandle>{3});
+
+    // Better: the worst entry is evicted
+    EXPECT_EQ(heap.Insert(2, 4), std::optional<NodeHandle>{0});
+
+    EXPECT_EQ(heap.PopBest(), 1);
+    EXPECT_EQ(heap.PopBest(), 4);
+    EXPECT_EQ(heap.PopBest(), 2);
+    EXPECT_TRUE(heap.IsEmpty());
+}
+
+TEST(BeamTest, HeapTiesKeepInsertionOrder)
+{
+    BeamHeap heap(2);
+    EXPECT_FALSE(heap.Insert(7, 0).has_value());
+    EXPECT_FALSE(heap.Insert(7, 1).has_value());
+    EXPECT_EQ(heap.Insert(7, 2), std::optional<NodeHandle>{2});
+
+    EXPECT_EQ(heap.PopBest(), 0);
+    EXPECT_EQ(heap.PopBest(), 1);
+}
+
+TEST(BeamTest, HeapMatchesSortedReference)
+{
+    std::mt19937 rng(kSeed);
+    std::uniform_int_distribution<int> value(0, 40);
+    std::uniform_int_distribution<int> op(0, 9);
+
+    BeamHeap heap(37);
+    std::vector<std::pair<int, NodeHandle>> reference;  // stable sorted by f
+    NodeHandle next_handle = 0;
+
+    for (int step = 0; step < 20000; ++step) {
+        const int action = op(rng);
+        if (action < 6 || reference.empty()) {
+            const int f                            = value(rng);
+            const NodeHandle handle                = next_handle++;
+            const std::optional<NodeHandle> result = heap.Insert(f, handle);
+
+            const auto pos = std::upper_bound(
+                reference.begin(), reference.end(), f,
+                [](const int lhs, const std::pair<int, NodeHandle> &rhs) {
+                    return lhs < rhs.first;
+                }
+            );
+            reference.insert(pos, {f, handle});
+
+            std::optional<NodeHandle> expected{};
+            if (reference.size() > heap.GetCapacity()) {
+                expected = reference.back().second;
+                reference.pop_back();
+            }
+            ASSERT_EQ(result, expected);
+        } else if (action < 9) {
+            ASSERT_EQ(heap.PopBest(), reference.front().second);
+            reference.erase(reference.begin());
+        } else {
+            ASSERT_EQ(heap.PopWorst(), reference.back().second);
+            reference.pop_back();
+        }
+
+        ASSERT_EQ(heap.Size(), reference.size());
+        if (!reference.empty()) {
+            ASSERT_EQ(heap.PeekBestF(), reference.front().first);
+            ASSERT_EQ(heap.PeekWorstF(), reference.back().first);
+        }
+    }
+}
+
+TEST(BeamTest, BucketQueuePopsLowestKeyNewestFirst)
+{
+    BucketQueue queue;
+    queue.Push(3, 0);
+    queue.Push(1, 1);
+    queue.Push(3, 2);
+    queue.Push(1, 3);
+    EXPECT_EQ(queue.GetSize(), 4);
+    EXPECT_EQ(queue.GetMinKey(), 1);
+
+    EXPECT_EQ(queue.PopMin(), 3);
+    EXPECT_EQ(queue.PopMin(), 1);
+    EXPECT_EQ(queue.GetMinKey(), 3);
+
+    // A key below the cursor moves it back
+    queue.Push(0, 4);
+    EXPECT_EQ(queue.GetMinKey(), 0);
+    EXPECT_EQ(queue.PopMin(), 4);
+    EXPECT_EQ(queue.PopMin(), 2);
+    EXPECT_EQ(queue.PopMin(), 0);
+    EXPECT_TRUE(queue.IsEmpty());
+}
@@ -0,0 +1,64 @@
+#include "colour_refinement.hpp"
+#include "graph.hpp"
+#include "gtest/gtest.h"
+#include "random_gen.hpp"
+
+#include <algorithm>
+
+TEST(ColourRefinementTest, PermutedCopyAgreesInEveryRound)
+{
+    const auto [g1, unused] = GenerateExample(GraphSpec{12, 12, 0.4, 0.4, false});
+
+    // G2 is G1 with vertex v renamed to n - 1 - v
+    const Vertices n = g1.GetVertices();
+    Graph g2(n);
+    for (Vertex u = 0; u < n; ++u) {
+        for (Vertex v = 0; v < n; ++v) {
+            if (const Edges edges = g1.GetEdges(u, v); edges != 0) {
+                g2.AddEdges(n - 1 - u, n - 1 - v, edges);
+            }
+        }
+    }
+
+    const ColourRefinement refinement(g1, g2);
+    ASSERT_GE(refinement.GetRounds(), 1);
+    for (Vertex v = 0; v < n; ++v) {
+        EXPECT_EQ(refinement.GetAgreementDepth(v, n - 1 - v), refinement.GetRounds());
+    }
+}
+
+TEST(ColourRefinementTest, SecondRoundSeparatesEqualSignatures)
+{
+    // Vertices 1 of both graphs have one out-edge and one in-edge, but in G2 the out-neighbour has an extra in-edge
+    Graph g1(3);
+    g1.AddEdges(0, 1);
+    g1.AddEdges(1, 2);
+
+    Graph g2(4);
+    g2.AddEdges(0, 1);
+    g2.AddEdges(1, 2);
+    g2.AddEdges(3, 2);
+
+    const ColourRefinement refinement(g1, g2);
+    EXPECT_EQ(refinement.GetColourG1(0, 1), refinement.GetColourG2(0, 1));
+    ASSERT_GE(refinement.GetRounds(), 2);
+    EXPECT_EQ(refinement.GetAgreementDepth(1, 1), 1);
+}
+
+TEST(ColourRefinementTest, RankingOrderedByBoundThenTruncated)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{10, 16, 0.5, 0.4, false});
+    const PairLowerBounds bounds(g1, g2);
+
+    const CandidateRanking full(g1, g2, bounds);
+    const CandidateRanking top(g1, g2, bounds, 4);
+    ASSERT_EQ(full.GetLength(), g2.GetVertices());
+    ASSERT_EQ(top.GetLength(), 4);
+
+    for (Vertex v1 = 0; v1 < g1.GetVertices(); ++v1) {
+        for (const Vertex *it = full.Begin(v1) + 1; it != full.End(v1); ++it) {
+            EXPECT_LE(bounds.Get(v1, *(it - 1)), bounds.Get(v1, *it));
+        }
+        EXPECT_TRUE(std::equal(top.Begin(v1), top.End(v1), full.Begin(v1)));
+    }
+}
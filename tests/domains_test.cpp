@@ -0,0 +1,71 @@
+#include "domains.hpp"
+#include "graph.hpp"
+#include "gtest/gtest.h"
+
+#include <climits>
+
+TEST(DomainsTest, InitialDomainsFullWithSelfLoopCost)
+{
+    Graph g1(2);
+    g1.AddEdges(0, 0, 3);
+
+    Graph g2(70);
+    g2.AddEdges(5, 5, 1);
+
+    const CandidateDomains domains(g1, g2);
+    EXPECT_EQ(domains.GetSize(0), 70);
+    EXPECT_EQ(domains.GetSize(1), 70);
+    EXPECT_EQ(domains.GetPartialCost(0, 0), 3);
+    EXPECT_EQ(domains.GetPartialCost(0, 5), 2);
+    EXPECT_EQ(domains.GetPartialCost(1, 5), 0);
+}
+
+TEST(DomainsTest, AssignUpdatesPartialCostsAndRemovesTarget)
+{
+    // 0 -> 1 with 2 edges and 1 -> 0 with 1 edge in G1, G2 only has 0 -> 1 with 1 edge
+    Graph g1(2);
+    g1.AddEdges(0, 1, 2);
+    g1.AddEdges(1, 0, 1);
+
+    Graph g2(3);
+    g2.AddEdges(0, 1, 1);
+
+    const PairLowerBounds bounds(g1, g2);
+    CandidateDomains domains(g1, g2);
+
+    State state(2, 3);
+    state.set_mapping(0, 0);
+    ASSERT_TRUE(domains.Assign(g1, g2, bounds, state.mapping, 0, 0, 0, INT_MAX));
+
+    EXPECT_FALSE(domains.Contains(1, 0));
+    EXPECT_EQ(domains.GetSize(1), 2);
+
+    // 1 -> 1: one missing 0 -> 1 edge and the missing 1 -> 0 edge
+    EXPECT_EQ(domains.GetPartialCost(1, 1), 2);
+    // 1 -> 2: no edges at all between 0 and 2 in G2
+    EXPECT_EQ(domains.GetPartialCost(1, 2), 3);
+}
+
+TEST(DomainsTest, AssignPrunesAgainstThreshold)
+{
+    Graph g1(2);
+    g1.AddEdges(0, 1, 2);
+    g1.AddEdges(1, 0, 1);
+
+    Graph g2(3);
+    g2.AddEdges(0, 1, 1);
+
+    const PairLowerBounds bounds(g1, g2);
+
+    // Threshold 3 keeps only the candidate with partial cost 2
+    CandidateDomains domains(g1, g2);
+    State state(2, 3);
+    state.set_mapping(0, 0);
+    ASSERT_TRUE(domains.Assign(g1, g2, bounds, state.mapping, 0, 0, 0, 3));
+    EXPECT_EQ(domains.GetSize(1), 1);
+    EXPECT_TRUE(domains.Contains(1, 1));
+
+    // Threshold 2 empties the domain of vertex 1: the node is a dead end
+    CandidateDomains dead(g1, g2);
+    EXPECT_FALSE(dead.Assign(g1, g2, bounds, state.mapping, 0, 0, 0, 2));
+}
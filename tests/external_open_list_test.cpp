@@ -0,0 +1,87 @@
+#include "algos.hpp"
+#include "external_open_list.hpp"
+#include "gtest/gtest.h"
+#include "local_search.hpp"
+#include "random_gen.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+class ExternalOpenListTest : public ::testing::Test
+{
+    protected:
+    void TearDown() override { std::filesystem::remove_all(scratch_); }
+
+    std::filesystem::path scratch_{"test_open_list_scratch"};
+};
+
+TEST_F(ExternalOpenListTest, SpillsAndPopsInOrderOfF)
+{
+    std::mt19937 generator(kSeed);
+    std::uniform_int_distribution<int> pick_f(0, 20);
+
+    std::vector<std::pair<int, std::uint8_t>> pushed;
+    std::vector<std::pair<int, std::uint8_t>> popped;
+    {
+        /* Room for eight records of three bytes */
+        ExternalOpenList list(scratch_, 3, 24);
+        const auto push = [&](const std::uint8_t value) {
+            const int f                  = pick_f(generator);
+            const std::uint8_t record[3] = {value, static_cast<std::uint8_t>(f), value};
+            list.Push(f, record);
+            pushed.emplace_back(f, value);
+        };
+        const auto pop = [&] {
+            const int f = list.GetMinF();
+            std::uint8_t record[3]{};
+            list.PopMin(record);
+            ASSERT_EQ(record[0], record[2]);
+            ASSERT_EQ(record[1], f);
+            popped.emplace_back(f, record[0]);
+        };
+
+        for (int value = 0; value < 200; ++value) {
+            push(static_cast<std::uint8_t>(value));
+        }
+        EXPECT_GT(list.GetSpilledBytes(), 0U);
+
+        /* Pushes in between pops, some of them into buckets that are being read from their files */
+        for (int value = 200; value < 250; ++value) {
+            pop();
+            push(static_cast<std::uint8_t>(value));
+        }
+        while (!list.IsEmpty()) {
+            pop();
+        }
+    }
+
+    EXPECT_EQ(popped.size(), pushed.size());
+    std::sort(pushed.begin(), pushed.end());
+    std::vector<std::pair<int, std::uint8_t>> sorted_popped = popped;
+    std::sort(sorted_popped.begin(), sorted_popped.end());
+    EXPECT_EQ(sorted_popped, pushed);
+
+    /* After the interleaved part every pop takes the lowest f left */
+    for (std::size_t i = 51; i < popped.size(); ++i) {
+        EXPECT_LE(popped[i - 1].first, popped[i].first);
+    }
+    EXPECT_TRUE(std::filesystem::is_empty(scratch_));
+}
+
+TEST_F(ExternalOpenListTest, ExternalAStarFindsOptimalCost)
+{
+    for (int run = 0; run < 4; ++run) {
+        const auto [g1, g2] = GenerateExample(GraphSpec{6, 8, 0.4, 0.4, false});
+
+        SearchContext ctx{};
+        const std::vector<Mapping> external  = AccurateAStarExternal(g1, g2, 1, ctx, scratch_, 64);
+        const std::vector<Mapping> in_memory = AccurateAStar(g1, g2, 1);
+
+        ASSERT_EQ(external.size(), 1U);
+        ASSERT_EQ(external[0].get_mapped_count(), g1.GetVertices());
+        EXPECT_EQ(CalculateMappingCost(g1, g2, external[0]), CalculateMappingCost(g1, g2, in_memory[0]));
+    }
+}
@@ -0,0 +1,54 @@
+#include "algos.hpp"
+#include "gtest/gtest.h"
+#include "local_search.hpp"
+#include "random_gen.hpp"
+
+TEST(FrontierTest, MapsStarIntoLargerStarWithoutCost)
+{
+    Graph g1(4);
+    for (Vertex leaf = 1; leaf < 4; ++leaf) {
+        g1.AddEdges(0, leaf, 2);
+    }
+
+    /* Star centred at 5 hidden among isolated vertices */
+    Graph g2(12);
+    for (const Vertex leaf : {1, 3, 8, 10, 11}) {
+        g2.AddEdges(5, leaf, 2);
+    }
+
+    SearchContext ctx{};
+    const auto mappings = ApproxFrontier(g1, g2, 1, ctx);
+    ASSERT_EQ(mappings.size(), 1);
+    EXPECT_EQ(mappings[0].get_mapped_count(), g1.GetVertices());
+    EXPECT_EQ(CalculateMappingCost(g1, g2, mappings[0]), 0);
+    EXPECT_EQ(ctx.GetIncumbentCost(), 0);
+}
+
+TEST(FrontierTest, MapsEveryComponentOfDisconnectedG1)
+{
+    Graph g1(6);
+    g1.AddEdges(0, 1);
+    g1.AddEdges(1, 2);
+    g1.AddEdges(3, 4);
+
+    Graph g2(8);
+    g2.AddEdges(0, 1);
+    g2.AddEdges(1, 2);
+    g2.AddEdges(5, 6);
+
+    const auto mappings = ApproxFrontier(g1, g2, 1);
+    ASSERT_EQ(mappings.size(), 1);
+    EXPECT_EQ(mappings[0].get_mapped_count(), g1.GetVertices());
+    EXPECT_EQ(CalculateMappingCost(g1, g2, mappings[0]), 0);
+}
+
+TEST(FrontierTest, OfferedCostMatchesExtension)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{60, 90, 0.1, 0.15, true});
+
+    SearchContext ctx{};
+    const auto mappings = ApproxFrontier(g1, g2, 1, ctx);
+    ASSERT_EQ(mappings.size(), 1);
+    EXPECT_EQ(mappings[0].get_mapped_count(), g1.GetVertices());
+    EXPECT_EQ(ctx.GetIncumbentCost(), CalculateMappingCost(g1, g2, mappings[0]));
+}
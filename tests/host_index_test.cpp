@@ -0,0 +1,80 @@
+#include "algos.hpp"
+#include "gtest/gtest.h"
+#include "host_index.hpp"
+#include "random_gen.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class HostIndexTest : public ::testing::Test
+{
+    protected:
+    void TearDown() override { std::remove(index_filename_.c_str()); }
+
+    std::string index_filename_{"test_host_index.bin"};
+};
+
+TEST_F(HostIndexTest, RoundTripKeepsGraphAndPreprocessing)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{20, 40, 0.2, 0.3, false});
+    const auto computed = ComputeHostPreprocessing(g2);
+    BuildHostIndex(g2, *computed, index_filename_.c_str());
+
+    ASSERT_TRUE(HostIndex::IsIndexFile(index_filename_.c_str()));
+    const HostIndex index(index_filename_.c_str());
+    ASSERT_EQ(index.GetVertices(), g2.GetVertices());
+
+    const Graph loaded = index.LoadGraph();
+    EXPECT_EQ(loaded.GetEdges(), g2.GetEdges());
+    for (Vertex u = 0; u < g2.GetVertices(); ++u) {
+        for (Vertex v = 0; v < g2.GetVertices(); ++v) {
+            EXPECT_EQ(loaded.GetEdges(u, v), g2.GetEdges(u, v));
+        }
+    }
+
+    const auto preprocessing = index.LoadPreprocessing();
+    EXPECT_EQ(preprocessing->weighted_degrees, computed->weighted_degrees);
+    EXPECT_EQ(preprocessing->adjacency.GetOffsets(), computed->adjacency.GetOffsets());
+    ASSERT_EQ(preprocessing->signatures.size(), computed->signatures.size());
+    for (Vertex v = 0; v < g2.GetVertices(); ++v) {
+        EXPECT_EQ(preprocessing->signatures[v].out_edges, computed->signatures[v].out_edges);
+        EXPECT_EQ(preprocessing->signatures[v].in_edges, computed->signatures[v].in_edges);
+        EXPECT_EQ(preprocessing->signatures[v].self_loop, computed->signatures[v].self_loop);
+    }
+}
+
+TEST_F(HostIndexTest, DenseAndSparseDegreesAgree)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{12, 30, 0.3, 0.4, false});
+
+    const std::vector<std::uint64_t> degrees = ComputeWeightedDegrees(g2);
+    EXPECT_EQ(degrees, ComputeWeightedDegrees(g2, SparseAdjacency(g2)));
+
+    const std::vector<Vertex> order = SortByDegreeDescending(degrees);
+    ASSERT_EQ(order.size(), degrees.size());
+    for (std::size_t i = 1; i < order.size(); ++i) {
+        EXPECT_GE(degrees[order[i - 1]], degrees[order[i]]);
+    }
+}
+
+TEST_F(HostIndexTest, RejectsTextGraphFile)
+{
+    std::ofstream(index_filename_) << "2\n0 1\n1 0\n";
+
+    EXPECT_FALSE(HostIndex::IsIndexFile(index_filename_.c_str()));
+    EXPECT_THROW(HostIndex index(index_filename_.c_str()), std::runtime_error);
+}
+
+TEST_F(HostIndexTest, ResidentHostGivesSameResult)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{15, 25, 0.3, 0.4, true});
+    const auto expected = ApproxAStar(g1, g2, 1);
+
+    const ResidentHostScope resident(g2, ComputeHostPreprocessing(g2));
+    ASSERT_NE(FindResidentHost(g2), nullptr);
+    EXPECT_EQ(FindResidentHost(g1), nullptr);
+    EXPECT_EQ(ApproxAStar(g1, g2, 1), expected);
+}
@@ -0,0 +1,64 @@
+#include "local_search.hpp"
+#include "algos.hpp"
+#include "gtest/gtest.h"
+#include "random_gen.hpp"
+
+static int ExtensionCost(const Graph &g1, const Graph &g2, const Mapping &mapping)
+{
+    int cost = 0;
+    for (const auto &ext : GetMinimalEdgeExtension(g1, g2, mapping)) {
+        cost += static_cast<int>(ext.weight_needed - ext.weight_found);
+    }
+    return cost;
+}
+
+TEST(LocalSearchTest, MappingCostMatchesEdgeExtension)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{12, 15, 1.5, 1.0, false});
+
+    const auto mappings = ApproxAStar(g1, g2, 1);
+    ASSERT_EQ(mappings.size(), 1);
+    EXPECT_EQ(CalculateMappingCost(g1, g2, mappings[0]), ExtensionCost(g1, g2, mappings[0]));
+}
+
+TEST(LocalSearchTest, SwapRepairsExchangedImages)
+{
+    // Directed path 0 -> 1 -> 2 with distinct multiplicities, G2 is an exact copy
+    Graph g1(3);
+    g1.AddEdges(0, 1, 3);
+    g1.AddEdges(1, 2, 1);
+    const Graph g2 = g1;
+
+    Mapping mapping(3, 3);
+    mapping.set_mapping(0, 2);
+    mapping.set_mapping(1, 1);
+    mapping.set_mapping(2, 0);
+    ASSERT_GT(CalculateMappingCost(g1, g2, mapping), 0);
+
+    SearchContext ctx{};
+    const RefineResult result = RefineMapping(g1, g2, mapping, ctx);
+    EXPECT_EQ(result.final_cost, 0);
+    EXPECT_EQ(mapping.get_mapped_count(), 3);
+    EXPECT_EQ(ExtensionCost(g1, g2, mapping), 0);
+}
+
+TEST(LocalSearchTest, RefineNeverWorsensAndTracksCost)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{40, 55, 0.5, 0.6, true});
+
+    // A deliberately poor start: identity on the first vertices of G2
+    Mapping mapping(g1.GetVertices(), g2.GetVertices());
+    for (Vertex v = 0; v < g1.GetVertices(); ++v) {
+        mapping.set_mapping(v, v);
+    }
+    const int start_cost = ExtensionCost(g1, g2, mapping);
+
+    SearchContext ctx(std::chrono::milliseconds(5'000));
+    const RefineResult result = RefineMapping(g1, g2, mapping, ctx);
+
+    EXPECT_EQ(result.initial_cost, start_cost);
+    EXPECT_LE(result.final_cost, result.initial_cost);
+    EXPECT_EQ(result.final_cost, ExtensionCost(g1, g2, mapping));
+    EXPECT_EQ(ctx.GetIncumbentCost(), result.final_cost);
+    EXPECT_EQ(mapping.get_mapped_count(), g1.GetVertices());
+}
@@ -0,0 +1,62 @@
+#include "pair_bounds.hpp"
+#include "graph.hpp"
+#include "gtest/gtest.h"
+
+TEST(PairBoundsTest, SignatureSortedAndSelfLoopSeparated)
+{
+    Graph g(4);
+    g.AddEdges(0, 1, 2);
+    g.AddEdges(0, 2, 5);
+    g.AddEdges(0, 0, 3);
+    g.AddEdges(3, 0, 1);
+
+    const MultiplicitySignature sig = ComputeSignature(g, 0);
+    EXPECT_EQ(sig.out_edges, (std::vector<Edges>{5, 2}));
+    EXPECT_EQ(sig.in_edges, (std::vector<Edges>{1}));
+    EXPECT_EQ(sig.self_loop, 3);
+}
+
+TEST(PairBoundsTest, SortedPairingDeficit)
+{
+    // v1 needs out-edges {4, 1}, v2 offers {3, 3}: best pairing 4->3, 1->3 costs 1
+    Graph g1(3);
+    g1.AddEdges(0, 1, 4);
+    g1.AddEdges(0, 2, 1);
+
+    Graph g2(3);
+    g2.AddEdges(0, 1, 3);
+    g2.AddEdges(0, 2, 3);
+
+    const PairLowerBounds bounds(g1, g2);
+    EXPECT_EQ(bounds.Get(0, 0), 1);
+
+    // Vertex 1 of G2 has no out-edges at all: every out-edge of v1 must be added
+    EXPECT_EQ(bounds.Get(0, 1), 5);
+}
+
+TEST(PairBoundsTest, SelfLoopAndInEdgesCounted)
+{
+    Graph g1(2);
+    g1.AddEdges(0, 0, 4);
+    g1.AddEdges(1, 0, 2);
+
+    Graph g2(2);
+    g2.AddEdges(0, 0, 1);
+
+    const PairLowerBounds bounds(g1, g2);
+    EXPECT_EQ(bounds.Get(0, 0), 3 + 2);
+    EXPECT_EQ(bounds.Get(1, 1), 2);
+    EXPECT_EQ(bounds.Get(1, 0), 2);
+}
+
+TEST(PairBoundsTest, MissingEdgesFullyCounted)
+{
+    Graph g1(2);
+    g1.AddEdges(0, 1, 7);
+
+    Graph g2(2);
+
+    const PairLowerBounds bounds(g1, g2);
+    EXPECT_EQ(bounds.Get(0, 0), 7);
+    EXPECT_EQ(bounds.Get(1, 0), 7);
+}
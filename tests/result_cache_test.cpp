@@ -0,0 +1,92 @@
+#include "algos.hpp"
+#include "gtest/gtest.h"
+#include "random_gen.hpp"
+#include "result_cache.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+class ResultCacheTest : public ::testing::Test
+{
+    protected:
+    void TearDown() override { std::filesystem::remove_all(directory_); }
+
+    static Mapping MakeMapping_(const Graph &g1, const Graph &g2)
+    {
+        Mapping mapping(g1.GetVertices(), g2.GetVertices());
+        for (Vertex v = 0; v < g1.GetVertices(); ++v) {
+            mapping.set_mapping(v, g2.GetVertices() - 1 - v);
+        }
+        return mapping;
+    }
+
+    std::filesystem::path directory_{"test_result_cache"};
+};
+
+TEST_F(ResultCacheTest, StoreThenLookupRoundTrips)
+{
+    const auto [g1, g2]   = GenerateExample(GraphSpec{8, 16, 0.3, 0.3, false});
+    const Mapping mapping = MakeMapping_(g1, g2);
+
+    ResultCache cache(directory_, 1024 * 1024);
+    const std::string key = cache.MakeKey(g1, HashGraph(g2), "approx");
+    EXPECT_FALSE(cache.Lookup(key, g1, g2).has_value());
+
+    cache.Store(key, g1, g2, mapping);
+    const auto hit = cache.Lookup(key, g1, g2);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_TRUE(*hit == mapping);
+
+    /* Another process sees the same entry */
+    ResultCache other(directory_, 1024 * 1024);
+    EXPECT_TRUE(other.Lookup(key, g1, g2).has_value());
+    EXPECT_FALSE(other.Lookup(other.MakeKey(g1, HashGraph(g2), "anneal"), g1, g2).has_value());
+}
+
+TEST_F(ResultCacheTest, EvictsLeastRecentlyUsed)
+{
+    const auto [g1, g2]   = GenerateExample(GraphSpec{8, 16, 0.3, 0.3, false});
+    const Mapping mapping = MakeMapping_(g1, g2);
+
+    /* Room for two entries but not three */
+    ResultCache probe(directory_ / "probe", 1024 * 1024);
+    const std::string probe_key = probe.MakeKey(g1, HashGraph(g2), "probe");
+    probe.Store(probe_key, g1, g2, mapping);
+    const std::uint64_t entry_bytes = std::filesystem::file_size(directory_ / "probe" / (probe_key + ".map"));
+
+    ResultCache cache(directory_, 2 * entry_bytes + entry_bytes / 2);
+    const std::string first  = cache.MakeKey(g1, HashGraph(g2), "first");
+    const std::string second = cache.MakeKey(g1, HashGraph(g2), "second");
+    const std::string third  = cache.MakeKey(g1, HashGraph(g2), "third");
+
+    const auto past = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+    cache.Store(first, g1, g2, mapping);
+    cache.Store(second, g1, g2, mapping);
+    std::filesystem::last_write_time(directory_ / (first + ".map"), past);
+    std::filesystem::last_write_time(directory_ / (second + ".map"), past + std::chrono::minutes(1));
+
+    /* A hit makes the first entry the most recent one */
+    ASSERT_TRUE(cache.Lookup(first, g1, g2).has_value());
+    cache.Store(third, g1, g2, mapping);
+
+    EXPECT_TRUE(cache.Lookup(first, g1, g2).has_value());
+    EXPECT_FALSE(cache.Lookup(second, g1, g2).has_value());
+    EXPECT_TRUE(cache.Lookup(third, g1, g2).has_value());
+}
+
+TEST_F(ResultCacheTest, DamagedEntryIsMiss)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{8, 16, 0.3, 0.3, false});
+
+    ResultCache cache(directory_, 1024 * 1024);
+    const std::string key = cache.MakeKey(g1, HashGraph(g2), "approx");
+    cache.Store(key, g1, g2, MakeMapping_(g1, g2));
+
+    std::ofstream(directory_ / (key + ".map")) << "bajo_jajo-cache 1\n" << key << "\n8 16 0 0\n0 0 0\n";
+    EXPECT_FALSE(cache.Lookup(key, g1, g2).has_value());
+
+    /* An incomplete mapping is never stored */
+    cache.Store(key, g1, g2, Mapping(g1.GetVertices(), g2.GetVertices()));
+    EXPECT_FALSE(cache.Lookup(key, g1, g2).has_value());
+}
@@ -0,0 +1,132 @@
+#include "algos.hpp"
+#include "gtest/gtest.h"
+#include "local_search.hpp"
+#include "random_gen.hpp"
+#include "search_scheduler.hpp"
+
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Yields `slices - 1` times, sleeping through every slice, and logs its name when it finishes */
+static SearchTask SleepingTask_(
+    const std::string name, const int slices, std::vector<std::string> &log, std::mutex &log_mutex
+)
+{
+    for (int slice = 1; slice < slices; ++slice) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        co_yield SearchYield{};
+    }
+    std::lock_guard lock(log_mutex);
+    log.push_back(name);
+    co_return std::vector<Mapping>{};
+}
+
+static SearchTask ThrowingTask_()
+{
+    co_yield SearchYield{};
+    throw std::runtime_error("search failed");
+}
+
+TEST(SearchSchedulerTest, SlicedSearchesMatchBlockingEngines)
+{
+    const auto [g1, g2] = GenerateExample(GraphSpec{7, 9, 0.4, 0.4, false});
+
+    SearchContext accurate_ctx{};
+    SearchTask accurate = AccurateAStarTask(g1, g2, 1, accurate_ctx, 1);
+    int accurate_slices = 1;
+    while (!accurate.Resume()) {
+        ++accurate_slices;
+    }
+    EXPECT_GT(accurate_slices, 1);
+    const std::vector<Mapping> sliced = accurate.TakeResult();
+    const std::vector<Mapping> direct = AccurateAStar(g1, g2, 1);
+    ASSERT_EQ(sliced.size(), 1U);
+    EXPECT_EQ(CalculateMappingCost(g1, g2, sliced[0]), CalculateMappingCost(g1, g2, direct[0]));
+
+    SearchScheduler scheduler(2);
+    SearchContext approx_ctx{};
+    SearchContext scheduled_ctx{};
+    const auto approx_job   = scheduler.Submit(ApproxAStarTask(g1, g2, 1, approx_ctx, kDefaultBeamWidth, 0, 1));
+    const auto accurate_job = scheduler.Submit(AccurateAStarTask(g1, g2, 1, scheduled_ctx, 1));
+    scheduler.Run();
+
+    ASSERT_TRUE(scheduler.IsDone(approx_job));
+    ASSERT_TRUE(scheduler.IsDone(accurate_job));
+    EXPECT_GT(scheduler.GetSlices(approx_job), 1U);
+    EXPECT_TRUE(scheduler.TakeResult(approx_job)[0] == ApproxAStar(g1, g2, 1)[0]);
+    EXPECT_EQ(
+        CalculateMappingCost(g1, g2, scheduler.TakeResult(accurate_job)[0]),
+        CalculateMappingCost(g1, g2, direct[0])
+    );
+}
+
+TEST(SearchSchedulerTest, ShortJobsFinishFirst)
+{
+    std::vector<std::string> log;
+    std::mutex log_mutex;
+
+    SearchScheduler scheduler(1);
+    const auto long_job  = scheduler.Submit(SleepingTask_("long", 40, log, log_mutex));
+    const auto short_job = scheduler.Submit(SleepingTask_("short", 3, log, log_mutex));
+    scheduler.Run();
+
+    ASSERT_EQ(log, (std::vector<std::string>{"short", "long"}));
+    EXPECT_EQ(scheduler.GetSlices(long_job), 40U);
+    EXPECT_EQ(scheduler.GetSlices(short_job), 3U);
+}
+
+TEST(SearchSchedulerTest, SuspendedJobWaitsForResume)
+{
+    std::vector<std::string> log;
+    std::mutex log_mutex;
+
+    SearchScheduler scheduler(2);
+    const auto parked  = scheduler.Submit(SleepingTask_("parked", 3, log, log_mutex));
+    const auto running = scheduler.Submit(SleepingTask_("running", 3, log, log_mutex));
+    const auto failing = scheduler.Submit(ThrowingTask_());
+    scheduler.Suspend(parked);
+    scheduler.Run();
+
+    EXPECT_FALSE(scheduler.IsDone(parked));
+    EXPECT_EQ(scheduler.GetSlices(parked), 0U);
+    EXPECT_TRUE(scheduler.IsDone(running));
+    EXPECT_TRUE(scheduler.IsDone(failing));
+    EXPECT_THROW((void)scheduler.TakeResult(failing), std::runtime_error);
+
+    scheduler.Resume(parked);
+    scheduler.Run();
+    EXPECT_TRUE(scheduler.IsDone(parked));
+    EXPECT_EQ(log, (std::vector<std::string>{"running", "parked"}));
+}
+
+TEST(SearchSchedulerTest, HeldSchedulerWaitsForDetachedJobs)
+{
+    std::vector<std::string> log;
+    std::mutex log_mutex;
+    const auto logged = [&] {
+        std::lock_guard lock(log_mutex);
+        return log.size();
+    };
+
+    SearchScheduler scheduler(1);
+    scheduler.Hold();
+    std::thread runner([&scheduler] {
+        scheduler.Run();
+    });
+
+    /* Idle in between, Run() must still be there for the second job */
+    scheduler.SubmitDetached(SleepingTask_("first", 3, log, log_mutex));
+    while (logged() == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    scheduler.SubmitDetached(SleepingTask_("second", 2, log, log_mutex));
+
+    scheduler.Release();
+    runner.join();
+    EXPECT_EQ(log, (std::vector<std::string>{"first", "second"}));
+}
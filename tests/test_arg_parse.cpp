@@ -174,3 +174,161 @@ TEST_F(AppTest, ParseArgs_GenInvalidBool_Throws)
         std::runtime_error
     );
 }
+
+TEST_F(AppTest, ParseArgs_TimeLimit)
+{
+    const char *const argv[] = {"app", "--time-limit", "1500", "in.txt", "out.txt"};
+    ASSERT_NO_THROW(ParseArgs(5, argv));
+    EXPECT_EQ(g_AppState.time_limit_ms, 1500);
+    EXPECT_STREQ(g_AppState.file, "in.txt");
+    EXPECT_STREQ(g_AppState.output, "out.txt");
+}
+
+TEST_F(AppTest, ParseArgs_TimeLimitMissingValue_Throws)
+{
+    const char *const argv[] = {"app", "in.txt", "out.txt", "--time-limit"};
+    EXPECT_THROW(ParseArgs(4, argv), std::runtime_error);
+}
+
+TEST_F(AppTest, ParseArgs_BnbFlag)
+{
+    const char *const argv[] = {"app", "--bnb", "in.txt", "out.txt"};
+    ASSERT_NO_THROW(ParseArgs(4, argv));
+    EXPECT_TRUE(g_AppState.run_bnb);
+}
+
+TEST_F(AppTest, ParseArgs_BeamWidth)
+{
+    const char *const argv[] = {"app", "--approx", "--beam", "200", "in.txt", "out.txt"};
+    ASSERT_NO_THROW(ParseArgs(6, argv));
+    EXPECT_EQ(g_AppState.beam_width, 200);
+
+    const char *const argv_auto[] = {"app", "--approx", "--beam", "auto", "in.txt", "out.txt"};
+    g_AppState                    = AppState{};
+    ASSERT_NO_THROW(ParseArgs(6, argv_auto));
+    EXPECT_EQ(g_AppState.beam_width, UINT32_MAX);
+}
+
+TEST_F(AppTest, ParseArgs_BeamWidthZero_Throws)
+{
+    const char *const argv[] = {"app", "--beam", "0", "in.txt", "out.txt"};
+    EXPECT_THROW(ParseArgs(5, argv), std::runtime_error);
+}
+
+TEST_F(AppTest, ParseArgs_Threads)
+{
+    const char *const argv[] = {"app", "--approx", "--threads", "8", "in.txt", "out.txt"};
+    ASSERT_NO_THROW(ParseArgs(6, argv));
+    EXPECT_EQ(g_AppState.threads, 8);
+
+    const char *const argv_zero[] = {"app", "--threads", "0", "in.txt", "out.txt"};
+    g_AppState                    = AppState{};
+    EXPECT_THROW(ParseArgs(5, argv_zero), std::runtime_error);
+}
+
+TEST_F(AppTest, ParseArgs_Refine)
+{
+    const char *const argv[] = {"app", "--approx", "--refine", "250", "in.txt", "out.txt"};
+    ASSERT_NO_THROW(ParseArgs(6, argv));
+    EXPECT_EQ(g_AppState.refine_ms, 250);
+}
+
+TEST_F(AppTest, ParseArgs_Anneal)
+{
+    const char *const argv[] = {"app", "--anneal", "--time-limit", "1000", "in.txt", "out.txt"};
+    ASSERT_NO_THROW(ParseArgs(6, argv));
+    EXPECT_TRUE(g_AppState.run_anneal);
+    EXPECT_EQ(g_AppState.time_limit_ms, 1000);
+}
+
+TEST_F(AppTest, ParseArgs_Frontier)
+{
+    const char *const argv[] = {"app", "--frontier", "--anneal", "in.txt", "out.txt"};
+    ASSERT_NO_THROW(ParseArgs(5, argv));
+    EXPECT_TRUE(g_AppState.run_frontier);
+    EXPECT_TRUE(g_AppState.run_anneal);
+}
+
+TEST_F(AppTest, ParseArgs_Portfolio)
+{
+    const char *const argv[] = {"app", "--portfolio", "--bnb", "in.txt", "out.txt"};
+    ASSERT_NO_THROW(ParseArgs(5, argv));
+    EXPECT_TRUE(g_AppState.run_portfolio);
+    EXPECT_TRUE(g_AppState.run_bnb);
+}
+
+TEST_F(AppTest, ParseArgs_Candidates)
+{
+    const char *const argv[] = {"app", "--approx", "--candidates", "8", "in.txt", "out.txt"};
+    ASSERT_NO_THROW(ParseArgs(6, argv));
+    EXPECT_EQ(g_AppState.candidates, 8);
+}
+
+TEST_F(AppTest, ParseArgs_Batch)
+{
+    const char *const argv[] = {"app", "--approx", "--batch", "inputs", "results", "--memory-limit", "512"};
+    ASSERT_NO_THROW(ParseArgs(7, argv));
+    EXPECT_STREQ(g_AppState.batch, "inputs");
+    EXPECT_STREQ(g_AppState.batch_output, "results");
+    EXPECT_EQ(g_AppState.memory_limit_mb, 512);
+    EXPECT_EQ(g_AppState.file, nullptr);
+}
+
+TEST_F(AppTest, ParseArgs_BatchWithoutOutput_Throws)
+{
+    const char *const argv[] = {"app", "--batch", "inputs"};
+    EXPECT_THROW(ParseArgs(3, argv), std::runtime_error);
+}
+
+TEST_F(AppTest, ParseArgs_Serve)
+{
+    const char *const argv[] = {"app", "--serve", "/tmp/solver.sock", "host.txt", "--threads", "4"};
+    ASSERT_NO_THROW(ParseArgs(6, argv));
+    EXPECT_STREQ(g_AppState.serve_socket, "/tmp/solver.sock");
+    EXPECT_STREQ(g_AppState.serve_host, "host.txt");
+    EXPECT_EQ(g_AppState.threads, 4);
+    EXPECT_EQ(g_AppState.serve_timeout_ms, 0U);
+
+    g_AppState = AppState{};
+    const char *const timeout[] = {"app", "--serve", "/tmp/solver.sock", "host.txt", "--serve-timeout", "500"};
+    ASSERT_NO_THROW(ParseArgs(6, timeout));
+    EXPECT_EQ(g_AppState.serve_timeout_ms, 500U);
+
+    g_AppState = AppState{};
+    const char *const zero[] = {"app", "--serve", "/tmp/solver.sock", "host.txt", "--serve-timeout", "0"};
+    EXPECT_THROW(ParseArgs(6, zero), std::runtime_error);
+}
+
+TEST_F(AppTest, ParseArgs_BuildIndexAndIndex)
+{
+    const char *const build_argv[] = {"app", "--build-index", "host.txt", "host.idx"};
+    ASSERT_NO_THROW(ParseArgs(4, build_argv));
+    EXPECT_STREQ(g_AppState.build_index_input, "host.txt");
+    EXPECT_STREQ(g_AppState.build_index_output, "host.idx");
+
+    g_AppState = AppState{};
+    const char *const solve_argv[] = {"app", "--approx", "--index", "host.idx", "g1.txt", "out.txt"};
+    ASSERT_NO_THROW(ParseArgs(6, solve_argv));
+    EXPECT_STREQ(g_AppState.index, "host.idx");
+    EXPECT_STREQ(g_AppState.file, "g1.txt");
+}
+
+TEST_F(AppTest, ParseArgs_Cache)
+{
+    const char *const argv[] = {"app", "--approx", "--cache", "cache_dir", "--cache-size", "64", "in.txt", "out.txt"};
+    ASSERT_NO_THROW(ParseArgs(8, argv));
+    EXPECT_STREQ(g_AppState.cache, "cache_dir");
+    EXPECT_EQ(g_AppState.cache_size_mb, 64U);
+
+    g_AppState = AppState{};
+    const char *const zero[] = {"app", "--approx", "--cache", "cache_dir", "--cache-size", "0", "in.txt", "out.txt"};
+    EXPECT_THROW(ParseArgs(8, zero), std::runtime_error);
+}
+
+TEST_F(AppTest, ParseArgs_Scratch)
+{
+    const char *const argv[] = {"app", "--scratch", "scratch_dir", "--memory-limit", "512", "in.txt", "out.txt"};
+    ASSERT_NO_THROW(ParseArgs(7, argv));
+    EXPECT_STREQ(g_AppState.scratch, "scratch_dir");
+    EXPECT_EQ(g_AppState.memory_limit_mb, 512U);
+}
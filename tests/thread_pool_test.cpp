@@ -0,0 +1,85 @@
+#include "gtest/gtest.h"
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce)
+{
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> visits(1000);
+
+    pool.ParallelFor(0, visits.size(), 7, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t idx = begin; idx < end; ++idx) {
+            visits[idx].fetch_add(1);
+        }
+    });
+
+    for (const auto &count : visits) {
+        EXPECT_EQ(count.load(), 1);
+    }
+}
+
+TEST(ThreadPoolTest, NestedGroupsFinishOnSingleWorker)
+{
+    ThreadPool pool(1);
+    std::atomic<int> leaves{0};
+
+    TaskGroup outer(pool);
+    for (int task = 0; task < 4; ++task) {
+        outer.Run([&] {
+            pool.ParallelFor(0, 8, 1, [&](std::size_t, std::size_t) {
+                leaves.fetch_add(1);
+            });
+        });
+    }
+    outer.Wait();
+
+    EXPECT_EQ(leaves.load(), 32);
+}
+
+TEST(ThreadPoolTest, WaitRethrowsAndCancelSkipsQueuedTasks)
+{
+    ThreadPool pool(2);
+    std::atomic<int> started{0};
+
+    TaskGroup group(pool);
+    group.Run([] {
+        throw std::runtime_error("task failed");
+    });
+    EXPECT_THROW(group.Wait(), std::runtime_error);
+    EXPECT_TRUE(group.IsCancelled());
+
+    for (int task = 0; task < 16; ++task) {
+        group.Run([&] {
+            started.fetch_add(1);
+        });
+    }
+    group.Wait();
+    EXPECT_EQ(started.load(), 0);
+}
+
+TEST(ThreadPoolTest, ShortLivedGroupsSurviveTheirLastTask)
+{
+    ThreadPool pool(4);
+    std::atomic<int> done{0};
+
+    /* Every group is freed right after Wait(), while the worker that ran its last task may still be leaving it. On the
+     * heap the sanitizers see a late access, on the stack the next group would take the same slot. */
+    for (int round = 0; round < 20'000; ++round) {
+        auto group = std::make_unique<TaskGroup>(pool);
+        group->Run([&] {
+            done.fetch_add(1, std::memory_order_relaxed);
+        });
+        group->Wait();
+    }
+    for (int round = 0; round < 5'000; ++round) {
+        pool.ParallelFor(0, 4, 1, [&](std::size_t, std::size_t) {
+            done.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+
+    EXPECT_EQ(done.load(), 40'000);
+}